@@ -60,6 +60,21 @@
 // 内存池示例
 #define T_MemoryDemo 0
 
+// 多尺寸级别分配器示例
+#define T_SizeClassAllocatorDemo 0
+
+// 内存池中央空闲链表竞争测试（互斥锁 vs 无锁）
+#define T_MemoryPoolContentionDemo 0
+
+// 内存池大页与NUMA本地化chunk测试（1GB对象池随机访问延迟与dTLB未命中）
+#define T_HugePageDemo 0
+
+// 池化共享指针（控制块与对象单次分配）对比make_shared
+#define T_PooledSharedPtrDemo 0
+
+// 单调递增内存区（每请求临时对象）对比全局堆
+#define T_MonotonicArenaDemo 0
+
 // 动画效果的按钮
 #define T_PushButtonDemo 0
 
@@ -78,9 +93,54 @@
 // 线程池示例
 #define T_ThreadDemo 0
 
+// 线程池工作窃取调度性能对比
+#define T_WorkStealingDemo 0
+
+// 线程池任务优先级与老化
+#define T_TaskPriorityDemo 0
+
+// 线程池提交任务的堆分配次数统计
+#define T_TaskAllocationDemo 0
+
+// 弹性线程池随负载扩容与回收
+#define T_ElasticThreadPoolDemo 0
+
+// 全局执行器延迟创建与启动耗时对比
+#define T_GlobalExecutorDemo 0
+
+// CPU亲和性与NUMA节点分组
+#define T_ThreadAffinityDemo 0
+
+// 线程池运行统计：排队延迟、执行时间、利用率
+#define T_ThreadPoolStatsDemo 0
+
+// 线程安全队列批量出队与关闭
+#define T_ThreadSafeQueueBulkDemo 0
+
+// 在共享线程池上串行执行的Strand
+#define T_StrandDemo 0
+
+// C++20协程在线程池与执行器之间切换
+#define T_CoroutineDemo 0
+
+// 分层时间轮定时器
+#define T_TimerWheelDemo 0
+
+// 任务依赖图与非阻塞后续任务
+#define T_TaskGraphDemo 0
+
+// 并行算法（parallel_for/reduce/transform/sort）扩展性测试
+#define T_ParallelAlgorithmsDemo 0
+
 // 线程安全队列
 #define T_ThreadSafeQueueDemo 0
 
+// 无锁MPMC队列与线程安全队列吞吐量对比
+#define T_MpmcQueueDemo 0
+
+// SPSC环形队列与单生产者模式执行器吞吐量
+#define T_SpscQueueDemo 0
+
 // 消息重定向
 #define T_UniversalRedirectorDemo 0
 
@@ -0,0 +1,133 @@
+#include "DemoHead.h"
+
+#if T_CoroutineDemo
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "ThreadExecutor.hpp"
+#include "TimeCounter.h"
+
+#if THREAD_HAS_COROUTINES
+
+// 模拟一次计算：占用当前线程cost时间
+int Compute(int input, std::chrono::microseconds cost)
+{
+    std::this_thread::sleep_for(cost);
+    return input * 2;
+}
+
+std::string ThreadName()
+{
+    std::ostringstream stream;
+    stream << std::this_thread::get_id();
+    return stream.str();
+}
+
+// 在io线程和计算线程池之间来回切换
+CoTask<int> HopBetweenThreads(ThreadExecutor& io, ThreadPool& pool)
+{
+    co_await io.schedule();
+    std::cout << "  parse request on io thread      " << ThreadName() << "\n";
+
+    const int result = co_await pool.post_awaitable([]() { return Compute(21, std::chrono::microseconds(100)); });
+    std::cout << "  computed " << result << " on pool thread       " << ThreadName() << "\n";
+
+    co_await io.schedule();
+    std::cout << "  write response on io thread     " << ThreadName() << "\n";
+
+    const int checked = co_await io.post_awaitable([result]() { return result + 0; });
+    co_return checked;
+}
+
+// 一个请求：在io线程上收到，计算放到线程池，结果回到io线程
+CoTask<void> HandleRequest(ThreadExecutor& io, ThreadPool& pool, int input, std::atomic<int64_t>& sum, std::atomic<int>& remaining)
+{
+    co_await io.schedule();
+    const int result = co_await pool.post_awaitable([input]() { return Compute(input, std::chrono::microseconds(500)); });
+    co_await io.schedule();
+    sum.fetch_add(result);
+    remaining.fetch_sub(1);
+}
+
+// 计算任务抛出的异常在co_await处重新抛出
+CoTask<int> FailingCompute(ThreadPool& pool)
+{
+    co_return co_await pool.post_awaitable([]() -> int { throw std::runtime_error("compute failed"); });
+}
+
+int main()
+{
+    ThreadExecutor io("io");
+    io.start();
+    ThreadPool pool(8);
+
+    // 1. 在线程之间切换
+    std::cout << "main thread " << ThreadName() << "\n";
+    const int result = sync_wait(HopBetweenThreads(io, pool));
+    std::cout << "result: " << result << "\n\n";
+
+    // 2. 一个io线程处理requests个请求，每个请求需要500us计算
+    const int requests = 2000;
+    std::cout << std::fixed << std::setprecision(1);
+
+    // 阻塞方式：io线程提交计算后等待future，等待期间io线程什么也做不了
+    {
+        std::atomic<int64_t> sum{0};
+        TimeCounter counter;
+        for (int i = 0; i < requests; ++i)
+        {
+            io.post([&pool, &sum, i]()
+                    {
+                        sum.fetch_add(pool.enqueue(Compute, i, std::chrono::microseconds(500)).get());
+                    });
+        }
+        io.postAndWait([]() {});
+        std::cout << "blocking future on io thread: " << std::setw(8) << counter.elapsed_micro() / 1000.0 << " ms, sum " << sum.load() << "\n";
+    }
+
+    // 协程方式：io线程只负责收发，计算期间可以处理其他请求
+    {
+        std::atomic<int64_t> sum{0};
+        std::atomic<int> remaining{requests};
+        TimeCounter counter;
+        for (int i = 0; i < requests; ++i)
+        {
+            start_detached(HandleRequest(io, pool, i, sum, remaining));
+        }
+        while (remaining.load() > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        std::cout << "co_await on io thread:        " << std::setw(8) << counter.elapsed_micro() / 1000.0 << " ms, sum " << sum.load() << "\n";
+    }
+
+    // 3. 异常传递
+    try
+    {
+        sync_wait(FailingCompute(pool));
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "\nexception from pool task: " << e.what() << "\n";
+    }
+
+    io.stop();
+    return 0;
+}
+
+#else
+
+int main()
+{
+    std::cout << "T_CoroutineDemo requires a compiler with C++20 coroutine support\n";
+    return 0;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,84 @@
+#include "DemoHead.h"
+
+#if T_ElasticThreadPoolDemo
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include "ThreadPool.hpp"
+
+// 模拟一段流量：每毫秒提交requests_per_ms个阻塞型请求（如同步IO），统计排队延迟的p50/p99
+void RunTraffic(ThreadPool& pool, const char* phase, int duration_ms, int requests_per_ms, std::chrono::milliseconds request_cost)
+{
+    std::vector<std::future<int64_t>> latencies;
+    const auto begin = std::chrono::steady_clock::now();
+    for (int ms = 0; ms < duration_ms; ++ms)
+    {
+        for (int i = 0; i < requests_per_ms; ++i)
+        {
+            const auto submitted = std::chrono::steady_clock::now();
+            latencies.push_back(pool.enqueue([submitted, request_cost]()
+                                             {
+                                                 const auto started = std::chrono::steady_clock::now();
+                                                 std::this_thread::sleep_for(request_cost);
+                                                 return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(started - submitted).count());
+                                             }));
+        }
+        std::this_thread::sleep_until(begin + std::chrono::milliseconds(ms + 1));
+    }
+
+    std::vector<int64_t> results;
+    for (auto& latency : latencies)
+    {
+        results.push_back(latency.get());
+    }
+    std::sort(results.begin(), results.end());
+
+    const ThreadPoolElasticStats stats = pool.get_elastic_stats();
+    std::cout << std::setw(8) << phase
+              << "  queue wait p50 " << std::setw(8) << std::fixed << std::setprecision(2) << results[results.size() / 2] / 1000.0 << " ms"
+              << "  p99 " << std::setw(8) << results[results.size() * 99 / 100] / 1000.0 << " ms"
+              << "  | threads " << std::setw(3) << stats.threads
+              << "  peak " << std::setw(3) << stats.peak_threads
+              << "  spawned " << std::setw(3) << stats.spawned
+              << "  retired " << std::setw(3) << stats.retired << "\n";
+}
+
+// 低谷 -> 高峰 -> 低谷，之后等待空闲线程回收
+void RunDay(ThreadPool& pool)
+{
+    const auto request_cost = std::chrono::milliseconds(5);
+    RunTraffic(pool, "quiet", 500, 1, request_cost);
+    RunTraffic(pool, "peak", 1000, 8, request_cost);
+    RunTraffic(pool, "quiet", 500, 1, request_cost);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    const ThreadPoolElasticStats stats = pool.get_elastic_stats();
+    std::cout << std::setw(8) << "idle" << "  threads after idle timeout: " << stats.threads << " (retired " << stats.retired << ")\n";
+}
+
+int main()
+{
+    std::cout << "Fixed pool, 8 threads\n";
+    {
+        ThreadPool pool(8);
+        RunDay(pool);
+    }
+
+    std::cout << "\nElastic pool, 4..64 threads, spawn after 10 ms queue wait, retire after 1 s idle\n";
+    {
+        ThreadPoolElasticConfig config;
+        config.min_threads = 4;
+        config.max_threads = 64;
+        config.spawn_wait_threshold = std::chrono::milliseconds(10);
+        config.idle_timeout = std::chrono::seconds(1);
+
+        ThreadPool pool(config);
+        RunDay(pool);
+    }
+
+    return 0;
+}
+
+#endif
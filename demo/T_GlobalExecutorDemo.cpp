@@ -0,0 +1,89 @@
+#include "DemoHead.h"
+
+#if T_GlobalExecutorDemo
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <memory>
+#include <vector>
+#include "Signal.hpp"
+#include "TimeCounter.h"
+
+// 当前进程的线程数（Linux读取/proc，其他平台返回0）
+size_t ProcessThreadCount()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.rfind("Threads:", 0) == 0)
+        {
+            return std::stoul(line.substr(8));
+        }
+    }
+    return 0;
+}
+
+class Counter : public Object
+{
+public:
+    void slotAdd(int value)
+    {
+        total.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    std::atomic<int> total{0};
+};
+
+int main()
+{
+    // 本文件包含了Signal.hpp/Object.h；改造前这里已经有65个线程（每个包含Object.h的编译单元再多64个）
+    std::cout << "threads at start of main: " << ProcessThreadCount() << "\n\n";
+
+    // 1. 改造前的代价：模拟N个编译单元各自的 static ThreadPool global_thread_pool(64)
+    for (size_t units : {1, 4, 16})
+    {
+        TimeCounter counter;
+        std::vector<std::unique_ptr<ThreadPool>> pools;
+        for (size_t i = 0; i < units; ++i)
+        {
+            pools.push_back(std::make_unique<ThreadPool>(64));
+        }
+        const int64_t startup_us = counter.elapsed_micro();
+        const size_t threads = ProcessThreadCount();
+
+        counter.reset();
+        pools.clear();
+        std::cout << "old: " << units << " translation unit(s) x 64 threads: startup " << startup_us / 1000.0 << " ms"
+                  << ", " << threads << " threads, teardown " << counter.elapsed_micro() / 1000.0 << " ms\n";
+    }
+
+    // 2. 全局执行器：构造对象、连接信号都不会创建线程，第一次异步发射时才创建
+    Counter receiver;
+    Signal<int> signal;
+    signal.connect(&receiver, SLOT(Counter::slotAdd));
+    std::cout << "\nafter connect: executor created = " << GlobalExecutor::created() << ", threads " << ProcessThreadCount() << "\n";
+
+    TimeCounter counter;
+    signal.emitAsync(1);
+    const int64_t first_emit_us = counter.elapsed_micro();
+    std::cout << "first emitAsync (creates executor): " << first_emit_us / 1000.0 << " ms, threads " << ProcessThreadCount() << "\n";
+
+    counter.reset();
+    for (int i = 0; i < 10000; ++i)
+    {
+        signal.emitAsync(1);
+    }
+    GlobalExecutor::instance().wait_until_empty();
+    std::cout << "10000 more emitAsync: " << counter.elapsed_micro() / 1000.0 << " ms\n";
+
+    counter.reset();
+    GlobalExecutor::shutdown();
+    std::cout << "orderly shutdown: " << counter.elapsed_micro() / 1000.0 << " ms, total " << receiver.total.load()
+              << ", threads " << ProcessThreadCount() << "\n";
+
+    return 0;
+}
+
+#endif
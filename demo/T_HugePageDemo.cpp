@@ -0,0 +1,156 @@
+#include "DemoHead.h"
+
+#if T_HugePageDemo
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstring>
+#include "ObjectPool.hpp"
+#include "TimeCounter.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#endif
+
+// 64字节对象，1GB内存池约1600万个
+struct Record
+{
+    Record* next;
+    uint64_t payload[7];
+};
+
+// dTLB读未命中计数器（需要perf_event_paranoid允许，不可用时返回-1）
+class DtlbMissCounter
+{
+public:
+    DtlbMissCounter()
+    {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~DtlbMissCounter()
+    {
+#if defined(__linux__)
+        if (fd_ >= 0)
+        {
+            close(fd_);
+        }
+#endif
+    }
+
+    void Start()
+    {
+#if defined(__linux__)
+        if (fd_ >= 0)
+        {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    int64_t Stop()
+    {
+#if defined(__linux__)
+        uint64_t value = 0;
+        if (fd_ >= 0)
+        {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &value, sizeof(value)) == sizeof(value))
+            {
+                return static_cast<int64_t>(value);
+            }
+        }
+#endif
+        return -1;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+// 申请整个内存池的对象，按随机顺序串成链表后遍历：每一步几乎都落在不同的页上
+void RunBenchmark(const char* name, ChunkProvider* provider, size_t object_count, size_t hops)
+{
+    MemoryPoolConfig config;
+    config.chunk_block_count = 32768;  // 每个chunk 2MB
+    config.chunk_provider = provider;
+    ObjectPool<Record> pool(config);
+
+    TimeCounter counter;
+    std::vector<Record*> records(object_count);
+    for (auto& record : records)
+    {
+        record = pool.Construct();
+    }
+    const int64_t fill_us = counter.elapsed_micro();
+
+    std::shuffle(records.begin(), records.end(), std::mt19937_64(42));
+    for (size_t i = 0; i < object_count; ++i)
+    {
+        records[i]->next = records[(i + 1) % object_count];
+    }
+
+    DtlbMissCounter misses;
+    counter.reset();
+    misses.Start();
+    Record* current = records[0];
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < hops; ++i)
+    {
+        checksum += current->payload[0];
+        current = current->next;
+    }
+    const int64_t dtlb_misses = misses.Stop();
+    const int64_t walk_us = counter.elapsed_micro();
+
+    std::cout << std::setw(10) << name
+              << std::setw(12) << fill_us / 1000 << " ms"
+              << std::setw(12) << std::fixed << std::setprecision(1) << walk_us * 1000.0 / hops << " ns/hop"
+              << std::setw(14) << (dtlb_misses >= 0 ? std::to_string(dtlb_misses) : std::string("n/a"))
+              << "   (checksum " << checksum << ")\n";
+
+    for (auto record : records)
+    {
+        pool.Destroy(record);
+    }
+}
+
+int main()
+{
+    const size_t pool_bytes = size_t(1) << 30;   // 1GB
+    const size_t object_count = pool_bytes / sizeof(Record);
+    const size_t hops = 20000000;
+
+    std::cout << "1GB ObjectPool random walk (" << object_count << " objects, " << hops << " hops)\n";
+    std::cout << std::setw(10) << "provider" << std::setw(15) << "fill" << std::setw(19) << "latency" << std::setw(14) << "dTLB misses" << "\n";
+
+    RunBenchmark("heap", HeapChunkProvider::Default(), object_count, hops);
+
+    HugePageChunkProvider huge_pages;
+    RunBenchmark("hugepage", &huge_pages, object_count, hops);
+
+    std::cout << "\nhugetlb chunks: " << huge_pages.GetHugeTlbChunks()
+              << ", THP chunks: " << huge_pages.GetTransparentChunks()
+              << ", NUMA bound chunks: " << huge_pages.GetNumaBoundChunks() << "\n";
+    std::cout << "(hugetlb requires vm.nr_hugepages >= 512; dTLB counter requires kernel.perf_event_paranoid <= 2)\n";
+
+    return 0;
+}
+
+#endif
@@ -2,11 +2,15 @@
 
 #if T_MemoryDemo
 
+#include <atomic>
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 #include "MemoryPool.hpp"
 #include "ObjectPool.hpp"
 #include "PooledSharedPtr.hpp"
+#include "TimeCounter.h"
 
 // 内存池测试函数
 void MemoryPoolTest()
@@ -56,7 +60,8 @@ void MemoryPoolTest()
     std::cout << "\nBefore shrink:\n";
     pool.GetStats().Print(); // 打印收缩前的内存状态
 
-    pool.ShrinkToFit(50); // 尝试收缩内存池，保留50个空闲块
+    size_t released = pool.ShrinkToFit(50); // 尝试收缩内存池，保留50个空闲块
+    std::cout << "\nReleased chunks: " << released << "\n";
 
     std::cout << "\nAfter shrink:\n";
     pool.GetStats().Print(); // 打印收缩后的内存状态
@@ -68,9 +73,136 @@ void MemoryPoolTest()
     // 当smartStr离开作用域时，会自动调用自定义删除器将内存返回对象池
 }
 
+// 多个对象池在多个线程中并发使用（每个线程在每个池中都有独立的缓存）
+void MultiPoolThreadTest()
+{
+    struct Small { int value = 0; };
+    struct Large { char data[200] = {}; };
+
+    ObjectPool<Small> small_pool;
+    ObjectPool<Large> large_pool;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&small_pool, &large_pool, t]()
+                             {
+                                 for (int i = 0; i < 1000; ++i)
+                                 {
+                                     Small* s = small_pool.Construct();
+                                     Large* l = large_pool.Construct();
+                                     auto str = PooledSharedPtr<std::string>::Create("Thread_" + std::to_string(t));
+                                     s->value = i;
+                                     small_pool.Destroy(s);
+                                     large_pool.Destroy(l);
+                                 }
+                             });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join(); // 线程退出时各自的缓存自动归还到对应的池
+    }
+
+    std::cout << "\nSmall pool after threads exit:\n";
+    small_pool.GetStats().Print();
+    std::cout << "\nLarge pool after threads exit:\n";
+    large_pool.GetStats().Print();
+}
+
+// 批量构造/销毁测试：逐个构造 vs ConstructN/DestroyN
+void BatchConstructTest()
+{
+    struct Particle { float x = 0, y = 0, z = 0, w = 1; };
+
+    const size_t count = 100000;
+    const int rounds = 50;
+    ObjectPool<Particle> pool(32, 4096);
+    std::vector<Particle*> particles(count);
+
+    TimeCounter counter;
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (auto& p : particles)
+        {
+            p = pool.Construct();
+        }
+        for (auto p : particles)
+        {
+            pool.Destroy(p);
+        }
+    }
+    std::cout << "\nConstruct/Destroy one by one: " << counter.elapsed_micro() << " us\n";
+
+    counter.reset();
+    for (int r = 0; r < rounds; ++r)
+    {
+        pool.ConstructN(count, particles.data());
+        pool.DestroyN(particles.data(), count);
+    }
+    std::cout << "ConstructN/DestroyN:          " << counter.elapsed_micro() << " us\n";
+
+    pool.GetStats().Print();
+}
+
+// 自适应线程缓存测试：高频分配的线程缓存扩容，低频分配的线程保持较小容量
+void AdaptiveCacheTest()
+{
+    MemoryPoolConfig config;
+    config.thread_cache_size = 16;
+    config.min_thread_cache_size = 4;
+    config.max_thread_cache_size = 1024;
+    config.global_cache_limit = 1536;
+    config.cache_idle_interval = std::chrono::milliseconds(20);
+    MemoryPool pool(64, config);
+
+    std::atomic<bool> done{false};
+    std::thread busy([&pool, &done]()
+                     {
+                         std::vector<void*> blocks(512);
+                         for (int r = 0; r < 2000; ++r)
+                         {
+                             pool.AllocateBatch(blocks.size(), blocks.data());
+                             for (auto block : blocks)
+                             {
+                                 pool.Deallocate(block);
+                             }
+                         }
+                         while (!done) std::this_thread::yield();
+                     });
+    std::thread idle([&pool, &done]()
+                     {
+                         for (int r = 0; r < 20; ++r)
+                         {
+                             std::vector<void*> blocks(64);
+                             for (auto& block : blocks)
+                             {
+                                 block = pool.Allocate();
+                             }
+                             for (auto block : blocks)
+                             {
+                                 pool.Deallocate(block);
+                             }
+                             std::this_thread::sleep_for(std::chrono::milliseconds(30));
+                         }
+                         while (!done) std::this_thread::yield();
+                     });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(800));
+    std::cout << "\nAdaptive thread caches (busy thread vs idle thread):\n";
+    pool.GetStats().Print();
+
+    done = true;
+    busy.join();
+    idle.join();
+}
+
 int main(int argc, char** argv)
 {
     MemoryPoolTest(); // 运行测试
+    MultiPoolThreadTest();
+    BatchConstructTest();
+    AdaptiveCacheTest();
     return 0;
 }
 
@@ -0,0 +1,76 @@
+#include "DemoHead.h"
+
+#if T_MemoryPoolContentionDemo
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include "MemoryPool.hpp"
+#include "TimeCounter.h"
+
+// 多线程小对象反复申请释放：每轮申请的块数超过线程缓存大小，迫使线程频繁访问中央空闲链表
+double ChurnBenchmark(CentralListMode mode, size_t thread_count, size_t rounds, size_t blocks_per_round)
+{
+    MemoryPoolConfig config;
+    config.thread_cache_size = 32;
+    config.chunk_block_count = 4096;
+    config.central_mode = mode;
+    MemoryPool pool(64, config);
+
+    std::vector<std::thread> threads;
+    TimeCounter counter;
+    for (size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&pool, rounds, blocks_per_round]()
+                             {
+                                 std::vector<void*> blocks(blocks_per_round);
+                                 for (size_t r = 0; r < rounds; ++r)
+                                 {
+                                     for (auto& block : blocks)
+                                     {
+                                         block = pool.Allocate();
+                                         *static_cast<size_t*>(block) = r;
+                                     }
+                                     for (auto block : blocks)
+                                     {
+                                         pool.Deallocate(block);
+                                     }
+                                 }
+                             });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const double seconds = counter.elapsed_micro() / 1e6;
+    const double operations = 2.0 * thread_count * rounds * blocks_per_round;
+    return operations / seconds / 1e6;
+}
+
+int main()
+{
+    const size_t rounds = 2000;
+    const size_t blocks_per_round = 256;
+
+    std::cout << "MemoryPool central free list contention (Mops/s, higher is better)\n";
+    std::cout << std::setw(10) << "threads" << std::setw(12) << "mutex" << std::setw(12) << "lock-free" << "\n";
+
+    for (size_t thread_count : {1, 8, 32, 64})
+    {
+        // 线程越多每线程轮数越少，保持总操作量接近
+        const size_t thread_rounds = std::max<size_t>(rounds / thread_count, 10);
+        const double mutex_rate = ChurnBenchmark(CentralListMode::Mutex, thread_count, thread_rounds, blocks_per_round);
+        const double lock_free_rate = ChurnBenchmark(CentralListMode::LockFree, thread_count, thread_rounds, blocks_per_round);
+
+        std::cout << std::setw(10) << thread_count
+                  << std::setw(12) << std::fixed << std::setprecision(2) << mutex_rate
+                  << std::setw(12) << lock_free_rate << "\n";
+    }
+
+    return 0;
+}
+
+#endif
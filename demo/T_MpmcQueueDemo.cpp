@@ -0,0 +1,104 @@
+#include "DemoHead.h"
+
+#if T_MpmcQueueDemo
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include "ThreadSafeQueue.hpp"
+#include "MpmcQueue.hpp"
+#include "TimeCounter.h"
+
+// producers个生产者各写入messages_per_producer条消息，consumers个消费者读到结束标记(-1)为止
+// capacity: 队列容量
+template <typename Queue>
+double Throughput(size_t producers, size_t consumers, size_t messages_per_producer, size_t capacity)
+{
+    Queue queue(capacity);
+    std::vector<std::thread> threads;
+    std::vector<int64_t> sums(consumers, 0);
+
+    TimeCounter counter;
+    for (size_t c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&queue, &sums, c]()
+                             {
+                                 int64_t sum = 0;
+                                 while (true)
+                                 {
+                                     auto item = queue.wait_pop(std::chrono::seconds(10));
+                                     if (!item || *item < 0)
+                                     {
+                                         break;
+                                     }
+                                     sum += *item;
+                                 }
+                                 sums[c] = sum;
+                             });
+    }
+
+    std::vector<std::thread> producer_threads;
+    for (size_t p = 0; p < producers; ++p)
+    {
+        producer_threads.emplace_back([&queue, messages_per_producer]()
+                                      {
+                                          for (size_t i = 0; i < messages_per_producer; ++i)
+                                          {
+                                              queue.push(static_cast<int64_t>(i));
+                                          }
+                                      });
+    }
+
+    for (auto& thread : producer_threads)
+    {
+        thread.join();
+    }
+    for (size_t c = 0; c < consumers; ++c)
+    {
+        queue.push(int64_t(-1));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const double seconds = counter.elapsed_micro() / 1e6;
+
+    int64_t total = 0;
+    for (auto sum : sums)
+    {
+        total += sum;
+    }
+    const int64_t expected = static_cast<int64_t>(producers * (messages_per_producer * (messages_per_producer - 1) / 2));
+    if (total != expected)
+    {
+        std::cout << "checksum mismatch: " << total << " != " << expected << "\n";
+    }
+
+    return producers * messages_per_producer / seconds / 1e6;
+}
+
+int main()
+{
+    const size_t total_messages = 2000000;
+
+    std::cout << "Queue throughput, capacity 4096 (Mmsg/s, higher is better)\n";
+    std::cout << std::setw(12) << "P x C" << std::setw(18) << "ThreadSafeQueue" << std::setw(14) << "MpmcQueue" << "\n";
+
+    const std::pair<size_t, size_t> shapes[] = {{1, 1}, {2, 2}, {4, 4}, {8, 1}, {1, 8}, {8, 8}};
+    for (const auto& shape : shapes)
+    {
+        const size_t per_producer = total_messages / shape.first;
+        const double locked = Throughput<ThreadSafeQueue<int64_t>>(shape.first, shape.second, per_producer, 4096);
+        const double lock_free = Throughput<MpmcQueue<int64_t>>(shape.first, shape.second, per_producer, 4096);
+
+        std::cout << std::setw(8) << shape.first << " x " << shape.second
+                  << std::setw(18) << std::fixed << std::setprecision(2) << locked
+                  << std::setw(14) << lock_free << "\n";
+    }
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include "DemoHead.h"
+
+#if T_ParallelAlgorithmsDemo
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "ParallelAlgorithms.hpp"
+#include "TimeCounter.h"
+
+// 对给定参与线程数（调用线程 + cores-1个线程池线程）跑一轮各算法，返回各自耗时（微秒）
+std::vector<int64_t> RunRound(size_t cores, const std::vector<uint32_t>& source)
+{
+    // ThreadPool至少有一个线程，单核时用整段作为一块，只由调用线程执行
+    ThreadPool pool(std::max<size_t>(1, cores - 1));
+    const size_t grain = cores == 1 ? source.size() : 0;
+    std::vector<int64_t> times;
+    TimeCounter counter;
+
+    // parallel_for：逐元素做较重的数学运算（类似逐行处理图像）
+    std::vector<double> rows(source.size());
+    counter.reset();
+    parallel_for(pool, size_t(0), source.size(), [&](size_t i) { rows[i] = std::sqrt(static_cast<double>(source[i])) * std::sin(i * 0.001); }, grain);
+    times.push_back(counter.elapsed_micro());
+
+    // parallel_transform：逐元素哈希（类似批量计算哈希）
+    std::vector<uint64_t> hashes(source.size());
+    counter.reset();
+    parallel_transform(pool, source.begin(), source.end(), hashes.begin(), [](uint32_t value)
+                       {
+                           uint64_t hash = 1469598103934665603ull;
+                           for (int i = 0; i < 4; ++i)
+                           {
+                               hash = (hash ^ ((value >> (i * 8)) & 0xff)) * 1099511628211ull;
+                           }
+                           return hash;
+                       }, grain);
+    times.push_back(counter.elapsed_micro());
+
+    // parallel_reduce：求和（类似CSV列统计，无符号加法按模回绕，满足结合律）
+    counter.reset();
+    const uint64_t sum = parallel_reduce(pool, hashes.begin(), hashes.end(), uint64_t(0), std::plus<>(), grain);
+    times.push_back(counter.elapsed_micro());
+
+    // parallel_sort
+    std::vector<uint32_t> sorted = source;
+    counter.reset();
+    parallel_sort(pool, sorted.begin(), sorted.end(), std::less<>(), grain);
+    times.push_back(counter.elapsed_micro());
+
+    if (sum != std::accumulate(hashes.begin(), hashes.end(), uint64_t(0)))
+    {
+        std::cout << "parallel_reduce result differs from std::accumulate!\n";
+    }
+    if (!std::is_sorted(sorted.begin(), sorted.end()))
+    {
+        std::cout << "parallel_sort produced an unsorted result!\n";
+    }
+    return times;
+}
+
+int main()
+{
+    const size_t count = 8 << 20;
+    std::mt19937 rng(7);
+    std::vector<uint32_t> source(count);
+    for (auto& value : source)
+    {
+        value = rng();
+    }
+
+    std::vector<uint32_t> reference = source;
+    TimeCounter counter;
+    std::sort(reference.begin(), reference.end());
+    std::cout << count << " elements, std::sort baseline " << counter.elapsed_milli() << " ms\n\n";
+
+    std::vector<size_t> core_counts = {1, 2, 4, 8};
+    const size_t all = std::max(1u, std::thread::hardware_concurrency());
+    if (std::find(core_counts.begin(), core_counts.end(), all) == core_counts.end())
+    {
+        core_counts.push_back(all);
+    }
+
+    std::cout << std::setw(6) << "cores" << std::setw(20) << "for (ms/speedup)" << std::setw(20) << "transform" << std::setw(20) << "reduce" << std::setw(20) << "sort" << "\n";
+    std::vector<int64_t> baseline;
+    for (size_t cores : core_counts)
+    {
+        const std::vector<int64_t> times = RunRound(cores, source);
+        if (baseline.empty())
+        {
+            baseline = times;
+        }
+
+        std::cout << std::setw(6) << cores;
+        for (size_t i = 0; i < times.size(); ++i)
+        {
+            std::cout << std::setw(12) << std::fixed << std::setprecision(1) << times[i] / 1000.0
+                      << std::setw(7) << std::setprecision(2) << static_cast<double>(baseline[i]) / std::max<int64_t>(1, times[i]) << "x";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "(hardware concurrency: " << all << ")\n";
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,142 @@
+#include "DemoHead.h"
+
+#if T_PooledSharedPtrDemo
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ObjectPool.hpp"
+#include "PooledSharedPtr.hpp"
+#include "TimeCounter.h"
+
+// 统计全局operator new调用次数
+static std::atomic<size_t> g_global_news{0};
+
+// 防止编译器优化掉对象访问
+static std::atomic<uint64_t> g_checksum{0};
+
+void* operator new(size_t size)
+{
+    g_global_news.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+struct Message
+{
+    uint64_t id;
+    uint64_t payload[6];
+    explicit Message(uint64_t value) : id(value), payload{} {}
+};
+
+// 旧实现：对象放在对象池中，控制块由shared_ptr的自定义删除器路径单独从全局堆分配
+struct TwoAllocationPtr
+{
+    static std::shared_ptr<Message> Create(uint64_t value)
+    {
+        Message* obj = pool.Construct(value);
+        return std::shared_ptr<Message>(obj, [](Message* p) { pool.Destroy(p); });
+    }
+
+    inline static ObjectPool<Message> pool;
+};
+
+struct MakeSharedPtr
+{
+    static std::shared_ptr<Message> Create(uint64_t value)
+    {
+        return std::make_shared<Message>(value);
+    }
+};
+
+struct SingleAllocationPtr
+{
+    static std::shared_ptr<Message> Create(uint64_t value)
+    {
+        return PooledSharedPtr<Message>::Create(value);
+    }
+};
+
+// 多线程创建/销毁：每线程维持一个滑动窗口的存活对象，并复制一份制造引用计数的原子操作
+template <typename Factory>
+void RunBenchmark(const char* name, size_t thread_count, size_t iterations)
+{
+    const size_t window = 256;
+    const size_t news_before = g_global_news.load();
+
+    std::vector<std::thread> threads;
+    TimeCounter counter;
+    for (size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([iterations, window]()
+                             {
+                                 std::vector<std::shared_ptr<Message>> live(window);
+                                 uint64_t checksum = 0;
+                                 for (size_t i = 0; i < iterations; ++i)
+                                 {
+                                     auto ptr = Factory::Create(i);
+                                     std::shared_ptr<Message> copy = ptr;
+                                     checksum += copy->id;
+                                     live[i % window] = std::move(ptr);
+                                 }
+                                 live.clear();
+                                 g_checksum.fetch_add(checksum, std::memory_order_relaxed);
+                             });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const double seconds = counter.elapsed_micro() / 1e6;
+    const double total = static_cast<double>(thread_count * iterations);
+    const size_t news = g_global_news.load() - news_before;
+
+    std::cout << std::setw(16) << name << std::setw(10) << thread_count
+              << std::setw(14) << std::fixed << std::setprecision(2) << total / seconds / 1e6 << " Mops/s"
+              << std::setw(14) << std::setprecision(3) << news / total << " news/op\n";
+}
+
+int main()
+{
+    const size_t iterations = 1000000;
+
+    std::cout << std::setw(16) << "pointer" << std::setw(10) << "threads" << std::setw(21) << "throughput" << std::setw(22) << "global new" << "\n";
+    for (size_t threads : {1, 4, 8})
+    {
+        RunBenchmark<MakeSharedPtr>("make_shared", threads, iterations);
+        RunBenchmark<TwoAllocationPtr>("pool+deleter", threads, iterations);
+        RunBenchmark<SingleAllocationPtr>("PooledSharedPtr", threads, iterations);
+        std::cout << "\n";
+    }
+
+    // weak_ptr同样可用：控制块随最后一个weak_ptr一起归还内存池
+    std::weak_ptr<Message> weak;
+    {
+        auto strong = PooledSharedPtr<Message>::Create(42);
+        weak = strong;
+        std::cout << "weak lock while alive: " << (weak.lock() ? "ok" : "expired") << "\n";
+    }
+    std::cout << "weak lock after reset: " << (weak.lock() ? "ok" : "expired") << "\n";
+
+    PooledSharedPtr<Message>::GetStats().Print();
+    return 0;
+}
+
+#endif
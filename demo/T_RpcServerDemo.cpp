@@ -3,6 +3,7 @@
 #if T_RpcServerDemo
 
 #include <rest_rpc.hpp>
+#include "MonotonicArena.hpp"
 using namespace rest_rpc;
 
 std::string_view echo(std::string_view str)
@@ -16,6 +17,17 @@ struct dummy
 };
 int add(int a, int b) { return a + b; }
 
+// 临时字符串从连接的请求临时内存区分配，下一个请求到来时整体回收
+std::string repeat(std::string_view str, int times)
+{
+	std::pmr::string buffer(get_context().get_conn()->arena());
+	for (int i = 0; i < times; ++i)
+	{
+		buffer.append(str);
+	}
+	return std::string(buffer);
+}
+
 struct person
 {
 	int id;
@@ -39,6 +51,9 @@ void basict_usage()
 
 	server.register_handler<get_person>();
 
+	server.set_arena_factory([] { return std::make_unique<basic_request_arena<MonotonicArena>>(); });
+	server.register_handler<repeat>();
+
 	auto ec = server.async_start();
 	if (ec)
 	{
@@ -77,6 +92,13 @@ void basict_usage()
 				REST_LOG_INFO << "call result: " << r2.value.name;
 				assert(r2.value.name == "jack");
 			}
+
+			auto r3 = co_await client.call<repeat>(std::string("ab"), 3);
+			if (r3.ec == rpc_errc::ok)
+			{
+				REST_LOG_INFO << "call result: " << r3.value;
+				assert(r3.value == "ababab");
+			}
 		};
 
 	sync_wait(get_global_executor(), rpc_call());
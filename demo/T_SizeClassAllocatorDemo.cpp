@@ -0,0 +1,129 @@
+#include "DemoHead.h"
+
+#if T_SizeClassAllocatorDemo
+
+#include <iostream>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include "SizeClassAllocator.hpp"
+#include "TimeCounter.h"
+
+using PoolString = std::basic_string<char, std::char_traits<char>, PoolAllocator<char>>;
+
+// 节点密集型容器测试：list插入删除
+template <typename List>
+int64_t ListBenchmark(List& list, int rounds, int count)
+{
+    TimeCounter counter;
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            list.push_back(i);
+        }
+        list.clear();
+    }
+    return counter.elapsed_micro();
+}
+
+// 节点密集型容器测试：map插入删除
+template <typename Map>
+int64_t MapBenchmark(Map& map, int rounds, int count)
+{
+    TimeCounter counter;
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            map.emplace(i, i);
+        }
+        map.clear();
+    }
+    return counter.elapsed_micro();
+}
+
+// 字符串测试：超出SSO长度的短字符串反复创建销毁
+template <typename String>
+int64_t StringBenchmark(int rounds, int count)
+{
+    TimeCounter counter;
+    std::vector<String> strings;
+    strings.reserve(count);
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            strings.emplace_back(40 + i % 200, 'x');
+        }
+        strings.clear();
+    }
+    return counter.elapsed_micro();
+}
+
+int main()
+{
+    const int rounds = 50;
+    const int count = 20000;
+
+    // 1. 尺寸级别表
+    std::cout << "Size classes: ";
+    for (size_t i = 0; i < SizeClassAllocator::kClassCount; ++i)
+    {
+        std::cout << SizeClassAllocator::ClassSize(i) << " ";
+    }
+    std::cout << "\n\n";
+
+    // 2. list：全局堆 vs STL分配器适配器 vs pmr
+    {
+        std::list<int> heap_list;
+        std::list<int, PoolAllocator<int>> pool_list;
+        std::pmr::list<int> pmr_list(PoolMemoryResource::Default());
+
+        std::cout << "list  heap: " << ListBenchmark(heap_list, rounds, count) << " us\n";
+        std::cout << "list  pool: " << ListBenchmark(pool_list, rounds, count) << " us\n";
+        std::cout << "list  pmr : " << ListBenchmark(pmr_list, rounds, count) << " us\n";
+    }
+
+    // 3. map
+    {
+        std::map<int, int> heap_map;
+        std::map<int, int, std::less<int>, PoolAllocator<std::pair<const int, int>>> pool_map;
+        std::pmr::map<int, int> pmr_map(PoolMemoryResource::Default());
+
+        std::cout << "map   heap: " << MapBenchmark(heap_map, rounds, count) << " us\n";
+        std::cout << "map   pool: " << MapBenchmark(pool_map, rounds, count) << " us\n";
+        std::cout << "map   pmr : " << MapBenchmark(pmr_map, rounds, count) << " us\n";
+    }
+
+    // 4. string
+    std::cout << "string heap: " << StringBenchmark<std::string>(rounds, count) << " us\n";
+    std::cout << "string pool: " << StringBenchmark<PoolString>(rounds, count) << " us\n";
+
+    // 5. 内存统计
+    SizeClassAllocator& allocator = SizeClassAllocator::Default();
+    std::cout << "\nAll size classes:\n";
+    allocator.GetStats().Print();
+
+    for (size_t i = 0; i < SizeClassAllocator::kClassCount; ++i)
+    {
+        MemoryStats stats = allocator.GetClassStats(i);
+        if (stats.total_chunks > 0)
+        {
+            std::cout << "\nClass " << SizeClassAllocator::ClassSize(i) << " bytes:\n";
+            stats.Print();
+        }
+    }
+
+    std::cout << "\nLarge allocations in use: " << allocator.GetLargeAllocations() << "\n";
+
+    // 6. 收缩
+    allocator.ShrinkToFit(0);
+    std::cout << "\nAfter shrink:\n";
+    allocator.GetStats().Print();
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "DemoHead.h"
+
+#if T_SpscQueueDemo
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include "SpscQueue.hpp"
+#include "MpmcQueue.hpp"
+#include "ThreadSafeQueue.hpp"
+#include "ThreadExecutor.hpp"
+#include "TimeCounter.h"
+
+// 一个生产者一个消费者逐个传递消息
+template <typename Queue>
+double SingleTransfer(Queue& queue, size_t messages)
+{
+    TimeCounter counter;
+    int64_t sum = 0;
+    std::thread consumer([&queue, &sum, messages]()
+                         {
+                             for (size_t i = 0; i < messages; ++i)
+                             {
+                                 sum += *queue.wait_pop();
+                             }
+                         });
+
+    for (size_t i = 0; i < messages; ++i)
+    {
+        queue.push(static_cast<int64_t>(i));
+    }
+    consumer.join();
+
+    const double seconds = counter.elapsed_micro() / 1e6;
+    if (sum != static_cast<int64_t>(messages * (messages - 1) / 2))
+    {
+        std::cout << "checksum mismatch\n";
+    }
+    return messages / seconds / 1e6;
+}
+
+// SPSC批量传递：每次最多发布/取走batch个元素
+double BulkTransfer(size_t messages, size_t batch)
+{
+    SpscQueue<int64_t> queue(4096);
+    TimeCounter counter;
+    int64_t sum = 0;
+    std::thread consumer([&queue, &sum, messages, batch]()
+                         {
+                             std::vector<int64_t> items(batch);
+                             size_t received = 0;
+                             while (received < messages)
+                             {
+                                 const size_t n = queue.try_pop_bulk(items.begin(), batch);
+                                 if (n == 0)
+                                 {
+                                     if (auto item = queue.wait_pop())
+                                     {
+                                         sum += *item;
+                                         ++received;
+                                     }
+                                     continue;
+                                 }
+
+                                 for (size_t i = 0; i < n; ++i)
+                                 {
+                                     sum += items[i];
+                                 }
+                                 received += n;
+                             }
+                         });
+
+    std::vector<int64_t> items(batch);
+    size_t sent = 0;
+    while (sent < messages)
+    {
+        const size_t count = std::min(batch, messages - sent);
+        for (size_t i = 0; i < count; ++i)
+        {
+            items[i] = static_cast<int64_t>(sent + i);
+        }
+
+        size_t pushed = 0;
+        while (pushed < count)
+        {
+            const size_t n = queue.try_push_bulk(items.begin() + pushed, count - pushed);
+            if (n == 0)
+            {
+                queue.push(std::move(items[pushed]));
+                ++pushed;
+                continue;
+            }
+            pushed += n;
+        }
+        sent += count;
+    }
+    consumer.join();
+
+    const double seconds = counter.elapsed_micro() / 1e6;
+    if (sum != static_cast<int64_t>(messages * (messages - 1) / 2))
+    {
+        std::cout << "checksum mismatch\n";
+    }
+    return messages / seconds / 1e6;
+}
+
+// ThreadExecutor投递吞吐量
+double ExecutorPost(ThreadExecutorMode mode, size_t tasks)
+{
+    std::atomic<size_t> done{0};
+    TimeCounter counter;
+    {
+        ThreadExecutor executor("bench", mode);
+        executor.start();
+        for (size_t i = 0; i < tasks; ++i)
+        {
+            executor.post([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+        }
+        executor.postAndWait([]() {});
+    }
+
+    const double seconds = counter.elapsed_micro() / 1e6;
+    return done.load() / seconds / 1e6;
+}
+
+int main()
+{
+    const size_t messages = 5000000;
+
+    std::cout << "Single producer / single consumer throughput (Mmsg/s, higher is better)\n";
+    {
+        ThreadSafeQueue<int64_t> locked;
+        MpmcQueue<int64_t> mpmc(4096);
+        SpscQueue<int64_t> spsc(4096);
+        std::cout << std::setw(24) << "ThreadSafeQueue" << std::setw(10) << std::fixed << std::setprecision(2) << SingleTransfer(locked, messages) << "\n";
+        std::cout << std::setw(24) << "MpmcQueue" << std::setw(10) << SingleTransfer(mpmc, messages) << "\n";
+        std::cout << std::setw(24) << "SpscQueue" << std::setw(10) << SingleTransfer(spsc, messages) << "\n";
+    }
+    for (size_t batch : {8, 64, 256})
+    {
+        std::cout << std::setw(20) << "SpscQueue bulk " << std::setw(4) << batch << std::setw(10) << BulkTransfer(messages, batch) << "\n";
+    }
+
+    const size_t tasks = 1000000;
+    std::cout << "\nThreadExecutor post throughput (Mtasks/s)\n";
+    std::cout << std::setw(24) << "MultiProducer" << std::setw(10) << ExecutorPost(ThreadExecutorMode::MultiProducer, tasks) << "\n";
+    std::cout << std::setw(24) << "SingleProducer" << std::setw(10) << ExecutorPost(ThreadExecutorMode::SingleProducer, tasks) << "\n";
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,140 @@
+#include "DemoHead.h"
+
+#if T_StrandDemo
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "Strand.hpp"
+#include "ThreadExecutor.hpp"
+#include "TimeCounter.h"
+
+// 当前进程的线程数（Linux读取/proc，其他平台返回0）
+size_t ProcessThreadCount()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.rfind("Threads:", 0) == 0)
+        {
+            return std::stoul(line.substr(8));
+        }
+    }
+    return 0;
+}
+
+// 一个会话的状态：只在自己的串行执行器上修改，不加锁
+struct Session
+{
+    int64_t next = 0;           // 期望收到的下一条消息序号
+    int64_t errors = 0;         // 乱序的消息数
+    std::atomic<int> inside{0}; // 同时执行的任务数，串行执行时不超过1
+    int64_t overlaps = 0;       // 发现并发执行的次数
+};
+
+// 处理一条消息：检查顺序和互斥
+void Handle(Session& session, int64_t seq)
+{
+    if (session.inside.fetch_add(1) != 0)
+    {
+        session.overlaps++;
+    }
+    if (seq != session.next)
+    {
+        session.errors++;
+    }
+    session.next = seq + 1;
+    session.inside.fetch_sub(1);
+}
+
+// 向每个会话轮流投递messages条消息，等待全部处理完，返回耗时（毫秒）和线程数
+template <typename Executor>
+void Run(const char* name, std::vector<std::unique_ptr<Executor>>& executors, size_t messages, int64_t setup_us)
+{
+    const size_t sessions = executors.size();
+    std::vector<Session> states(sessions);
+    const size_t threads = ProcessThreadCount();
+
+    TimeCounter counter;
+    for (size_t i = 0; i < messages; ++i)
+    {
+        const size_t s = i % sessions;
+        const int64_t seq = static_cast<int64_t>(i / sessions);
+        Session* session = &states[s];
+        executors[s]->post([session, seq]() { Handle(*session, seq); });
+    }
+    for (auto& executor : executors)
+    {
+        executor->postAndWait([]() {});
+    }
+    const int64_t elapsed_us = counter.elapsed_micro();
+
+    int64_t errors = 0;
+    int64_t overlaps = 0;
+    for (const Session& session : states)
+    {
+        errors += session.errors;
+        overlaps += session.overlaps;
+    }
+
+    std::cout << std::left << std::setw(34) << name << std::right
+              << "  setup " << std::setw(8) << std::fixed << std::setprecision(1) << setup_us / 1000.0 << " ms"
+              << "  threads " << std::setw(5) << threads
+              << "  " << std::setw(8) << elapsed_us / 1000.0 << " ms for " << messages << " msgs"
+              << "  out of order " << errors << ", overlapping " << overlaps << "\n";
+}
+
+int main()
+{
+    const size_t messages = 400000;
+
+    // 1. 每个会话一个 ThreadExecutor：每个会话独占一个系统线程
+    for (size_t sessions : {64, 512})
+    {
+        TimeCounter counter;
+        std::vector<std::unique_ptr<ThreadExecutor>> executors;
+        for (size_t i = 0; i < sessions; ++i)
+        {
+            executors.push_back(std::make_unique<ThreadExecutor>());
+            executors.back()->start();
+        }
+        const int64_t setup_us = counter.elapsed_micro();
+        Run((std::to_string(sessions) + " ThreadExecutors").c_str(), executors, messages, setup_us);
+    }
+
+    // 2. 每个会话一个 Strand，全部复用一个线程池
+    ThreadPool pool(4, ThreadPoolMode::WorkStealing);
+    for (size_t sessions : {64, 512, 10000})
+    {
+        TimeCounter counter;
+        std::vector<std::unique_ptr<Strand>> strands;
+        for (size_t i = 0; i < sessions; ++i)
+        {
+            strands.push_back(std::make_unique<Strand>(pool));
+        }
+        const int64_t setup_us = counter.elapsed_micro();
+        Run((std::to_string(sessions) + " Strands on a 4-thread pool").c_str(), strands, messages, setup_us);
+    }
+
+    // 3. 空闲的 Strand 不占用线程池：没有任务时不会被调度
+    std::cout << "\nidle strands leave the pool empty: pending tasks " << pool.pending_tasks() << "\n";
+
+    // 4. 在 Strand 内部 postAndWait 直接执行，不会自己等自己
+    Strand strand(pool);
+    auto result = strand.postAndWaitWithResult<int>([&strand]()
+                                                    {
+                                                        int value = 0;
+                                                        strand.postAndWait([&value]() { value = 42; });
+                                                        return value;
+                                                    });
+    std::cout << "nested postAndWait inside the strand: " << result.get() << "\n";
+
+    return 0;
+}
+
+#endif
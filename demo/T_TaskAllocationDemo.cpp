@@ -0,0 +1,153 @@
+#include "DemoHead.h"
+
+#if T_TaskAllocationDemo
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <array>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "TimeCounter.h"
+
+// 统计全进程的堆分配次数（包括工作线程）
+static std::atomic<size_t> g_allocations{0};
+
+void* operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    const size_t align = static_cast<size_t>(alignment);
+    if (void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+// 执行body并打印平均每个任务的堆分配次数和耗时
+template <typename Body>
+void Measure(const char* name, size_t tasks, Body&& body)
+{
+    const size_t before = g_allocations.load();
+    TimeCounter counter;
+    body();
+    const int64_t elapsed_ns = counter.elapsed_nano();
+    const size_t allocations = g_allocations.load() - before;
+
+    std::cout << std::left << std::setw(44) << name << std::right
+              << std::setw(8) << std::fixed << std::setprecision(3) << static_cast<double>(allocations) / tasks << " allocs/task"
+              << std::setw(10) << std::setprecision(1) << static_cast<double>(elapsed_ns) / tasks << " ns/task\n";
+}
+
+int main()
+{
+    const size_t tasks = 200000;
+    ThreadPool pool(4);
+    std::vector<std::future<int>> futures;
+    futures.reserve(tasks);
+    std::atomic<size_t> counter{0};
+
+    // 预热：让内存池、环形队列、线程缓存都扩展到稳定大小
+    for (int round = 0; round < 2; ++round)
+    {
+        for (size_t i = 0; i < tasks; ++i)
+        {
+            futures.push_back(pool.enqueue([i]() { return static_cast<int>(i); }));
+        }
+        futures.clear();
+        pool.wait_until_empty();
+    }
+
+    // 改造前的提交方式：make_shared<packaged_task> + 捕获它的std::function
+    Measure("old path (inline): packaged_task + function", tasks, [&]()
+            {
+                for (size_t i = 0; i < tasks; ++i)
+                {
+                    auto task = std::make_shared<std::packaged_task<int()>>([i]() { return static_cast<int>(i); });
+                    std::future<int> future = task->get_future();
+                    std::function<void()> wrapper([task]() { (*task)(); });
+                    wrapper();
+                    future.get();
+                }
+            });
+
+    Measure("ThreadPool::enqueue + future.get()", tasks, [&]()
+            {
+                for (size_t i = 0; i < tasks; ++i)
+                {
+                    futures.push_back(pool.enqueue([i]() { return static_cast<int>(i); }));
+                }
+                for (auto& future : futures)
+                {
+                    future.get();
+                }
+                futures.clear();
+            });
+
+    Measure("ThreadPool::push (small lambda)", tasks, [&]()
+            {
+                for (size_t i = 0; i < tasks; ++i)
+                {
+                    pool.push([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+                }
+                pool.wait_until_empty();
+            });
+
+    std::unique_ptr<int> owned;
+    Measure("ThreadPool::push (move-only capture)", tasks, [&]()
+            {
+                for (size_t i = 0; i < tasks; ++i)
+                {
+                    // unique_ptr本身的分配不算提交开销，这里用空指针
+                    pool.push([&counter, ptr = std::move(owned)]() { counter.fetch_add(ptr ? 2 : 1, std::memory_order_relaxed); });
+                }
+                pool.wait_until_empty();
+            });
+
+    Measure("ThreadPool::push (128-byte capture, heap)", tasks, [&]()
+            {
+                for (size_t i = 0; i < tasks; ++i)
+                {
+                    std::array<char, 128> payload{};
+                    pool.push([&counter, payload]() { counter.fetch_add(payload[0] + 1, std::memory_order_relaxed); });
+                }
+                pool.wait_until_empty();
+            });
+
+    std::cout << "Task inline buffer: " << Task::kInlineSize << " bytes, sizeof(Task) = " << sizeof(Task) << "\n";
+    return 0;
+}
+
+#endif
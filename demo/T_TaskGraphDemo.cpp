@@ -0,0 +1,141 @@
+#include "DemoHead.h"
+
+#if T_TaskGraphDemo
+
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include "TaskGraph.hpp"
+#include "TimeCounter.h"
+
+// 模拟一个阶段的计算
+int Stage(int value, std::chrono::microseconds duration)
+{
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+    return value + 1;
+}
+
+int main()
+{
+    const int chains = 2000;
+    const auto stage_cost = std::chrono::microseconds(50);
+
+    // 1. 三阶段流水线：在工作线程里get()前一阶段 vs then()非阻塞串联
+    {
+        ThreadPool pool(4);
+        TimeCounter counter;
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < chains; ++i)
+        {
+            auto first = std::make_shared<std::future<int>>(pool.enqueue([=]() { return Stage(i, stage_cost); }));
+            auto second = std::make_shared<std::future<int>>(pool.enqueue([=]() { return Stage(first->get(), stage_cost); }));
+            results.push_back(pool.enqueue([=]() { return Stage(second->get(), stage_cost); }));
+        }
+        long long sum = 0;
+        for (auto& result : results)
+        {
+            sum += result.get();
+        }
+        std::cout << "blocking get() pipeline: " << counter.elapsed_milli() << " ms (sum " << sum << ")\n";
+    }
+
+    {
+        ThreadPool pool(4);
+        TimeCounter counter;
+        std::vector<TaskFuture<int>> results;
+        for (int i = 0; i < chains; ++i)
+        {
+            results.push_back(spawn_task(pool, [=]() { return Stage(i, stage_cost); })
+                                  .then(pool, [=](int value) { return Stage(value, stage_cost); })
+                                  .then(pool, [=](int value) { return Stage(value, stage_cost); }));
+        }
+        const std::vector<int> values = when_all(results).get();
+        std::cout << "then() pipeline:         " << counter.elapsed_milli() << " ms (sum " << std::accumulate(values.begin(), values.end(), 0LL) << ")\n";
+    }
+
+    // 2. 依赖图：分块求和 -> 两两归并 -> 汇总
+    {
+        ThreadPool pool(4);
+        const size_t blocks = 64;
+        const size_t block_size = 1 << 16;
+        std::vector<int> data(blocks * block_size, 1);
+        std::vector<long long> partial(blocks);
+
+        TaskGraph graph;
+        std::vector<TaskGraph::NodeId> level;
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            level.push_back(graph.add([&, b]()
+                                      {
+                                          partial[b] = std::accumulate(data.begin() + b * block_size, data.begin() + (b + 1) * block_size, 0LL);
+                                      }));
+        }
+
+        for (size_t stride = 1; level.size() > 1; stride *= 2)
+        {
+            std::vector<TaskGraph::NodeId> next;
+            for (size_t i = 0; i + 1 < level.size(); i += 2)
+            {
+                const size_t left = i * stride;
+                const size_t right = (i + 1) * stride;
+                const TaskGraph::NodeId merge = graph.add([&, left, right]() { partial[left] += partial[right]; });
+                graph.succeed(merge, {level[i], level[i + 1]});
+                next.push_back(merge);
+            }
+            level.swap(next);
+        }
+
+        TimeCounter counter;
+        graph.run(pool).get();
+        std::cout << "graph of " << graph.size() << " nodes: sum " << partial[0] << " (expected " << data.size() << ") in " << counter.elapsed_micro() << " us\n";
+    }
+
+    // 3. when_any与异常传递
+    {
+        ThreadPool pool(4);
+        std::vector<TaskFuture<int>> replicas;
+        for (int i = 0; i < 3; ++i)
+        {
+            replicas.push_back(spawn_task(pool, [i]()
+                                          {
+                                              std::this_thread::sleep_for(std::chrono::milliseconds(30 - i * 10));
+                                              return i;
+                                          }));
+        }
+        const auto fastest = when_any(replicas).get();
+        std::cout << "when_any: replica " << fastest.first << " answered first\n";
+
+        auto failed = spawn_task(pool, []() -> int { throw std::runtime_error("stage 1 failed"); })
+                          .then(pool, [](int value) { return value * 2; })
+                          .then(pool, [](int value) { std::cout << "never printed " << value << "\n"; });
+        try
+        {
+            failed.get();
+        }
+        catch (const std::exception& e)
+        {
+            std::cout << "exception propagated through the chain: " << e.what() << "\n";
+        }
+
+        TaskGraph graph;
+        const auto a = graph.add([]() { throw std::logic_error("node a failed"); });
+        const auto b = graph.add([]() {});
+        const auto c = graph.add([]() { std::cout << "never printed\n"; });
+        graph.succeed(c, {a, b});
+        try
+        {
+            graph.run(pool).get();
+        }
+        catch (const std::exception& e)
+        {
+            std::cout << "graph failed: " << e.what() << "\n";
+        }
+    }
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "DemoHead.h"
+
+#if T_TaskPriorityDemo
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "TimeCounter.h"
+
+// 模拟耗时的后台任务（压缩、导出等）
+void BusyWork(std::chrono::microseconds duration)
+{
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+}
+
+const char* PriorityName(TaskPriority priority)
+{
+    switch (priority)
+    {
+    case TaskPriority::Realtime: return "realtime";
+    case TaskPriority::Normal: return "normal";
+    default: return "background";
+    }
+}
+
+// 先灌入大量后台任务，再每隔一段时间提交一个请求处理任务，统计请求从提交到开始执行的延迟
+void RunScenario(ThreadPoolMode mode, TaskPriority request_priority)
+{
+    const size_t background_tasks = 2000;
+    const size_t requests = 50;
+
+    ThreadPool pool(4, mode);
+    for (size_t i = 0; i < background_tasks; ++i)
+    {
+        pool.push(TaskPriority::Background, []() { BusyWork(std::chrono::microseconds(500)); });
+    }
+
+    std::vector<std::future<int64_t>> latencies;
+    for (size_t i = 0; i < requests; ++i)
+    {
+        const auto submitted = std::chrono::steady_clock::now();
+        latencies.push_back(pool.enqueue(request_priority, [submitted]()
+                                         {
+                                             return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - submitted).count());
+                                         }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    std::vector<int64_t> results;
+    for (auto& latency : latencies)
+    {
+        results.push_back(latency.get());
+    }
+    std::sort(results.begin(), results.end());
+
+    std::cout << (mode == ThreadPoolMode::SharedQueue ? "shared" : "stealing") << ", requests as " << PriorityName(request_priority)
+              << ": p50 " << results[results.size() / 2] / 1000.0 << " ms"
+              << ", p99 " << results[results.size() * 99 / 100] / 1000.0 << " ms\n";
+
+    for (TaskPriority priority : {TaskPriority::Realtime, TaskPriority::Normal, TaskPriority::Background})
+    {
+        const ThreadPoolPriorityStats stats = pool.get_priority_stats(priority);
+        std::cout << std::setw(14) << PriorityName(priority)
+                  << "  depth " << std::setw(5) << stats.depth
+                  << "  peak " << std::setw(5) << stats.peak_depth
+                  << "  dequeued " << std::setw(5) << stats.dequeued
+                  << "  aged " << std::setw(4) << stats.aged
+                  << "  avg wait " << std::fixed << std::setprecision(2) << stats.AverageWaitMicros() / 1000.0 << " ms\n";
+    }
+}
+
+int main()
+{
+    std::cout << "Request latency while the pool is flooded with background work\n";
+    for (ThreadPoolMode mode : {ThreadPoolMode::SharedQueue, ThreadPoolMode::WorkStealing})
+    {
+        RunScenario(mode, TaskPriority::Background);    // 相当于没有优先级：请求和后台任务在同一个FIFO队列
+        RunScenario(mode, TaskPriority::Realtime);
+        std::cout << "\n";
+    }
+
+    return 0;
+}
+
+#endif
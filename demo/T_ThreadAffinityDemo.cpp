@@ -0,0 +1,214 @@
+#include "DemoHead.h"
+
+#if T_ThreadAffinityDemo
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "ThreadExecutor.hpp"
+#include "ThreadAffinity.hpp"
+#include "TimeCounter.h"
+
+// 两个线程分别绑定到cpu_a、cpu_b，轮流写同一个缓存行，返回每次往返的纳秒数（cpu为-1表示不绑定）
+double PingPong(int cpu_a, int cpu_b, int rounds)
+{
+    alignas(64) std::atomic<int> turn{0};
+
+    auto player = [&turn, rounds](int cpu, int self)
+    {
+        if (cpu >= 0)
+        {
+            ThreadAffinity::pin_current_thread({cpu});
+        }
+        for (int i = 0; i < rounds; ++i)
+        {
+            while (turn.load(std::memory_order_acquire) != self)
+            {
+                std::this_thread::yield();
+            }
+            turn.store(1 - self, std::memory_order_release);
+        }
+    };
+
+    TimeCounter counter;
+    std::thread a(player, cpu_a, 0);
+    std::thread b(player, cpu_b, 1);
+    a.join();
+    b.join();
+    return static_cast<double>(counter.elapsed_nano()) / rounds;
+}
+
+// 调用线程绑定到caller_cpu，返回ThreadExecutor::postAndWait的平均往返微秒数（executor_cpu为-1表示不绑定）
+double ExecutorRoundTrip(int caller_cpu, int executor_cpu, int rounds)
+{
+    ThreadAffinity::pin_current_thread({caller_cpu});
+
+    ThreadExecutor executor("affinity");
+    if (executor_cpu >= 0)
+    {
+        executor.set_affinity(executor_cpu);
+    }
+    executor.start();
+
+    std::vector<int> data(1024, 1);
+    long long sum = 0;
+    TimeCounter counter;
+    for (int i = 0; i < rounds; ++i)
+    {
+        executor.postAndWait([&data, &sum]() { sum += std::accumulate(data.begin(), data.end(), 0LL); });
+    }
+    const double elapsed = static_cast<double>(counter.elapsed_micro()) / rounds;
+
+    ThreadAffinity::pin_current_thread(ThreadAffinity::allowed_cpus());
+    return sum > 0 ? elapsed : 0.0;
+}
+
+// 每个节点一块数据，由push_to_node提交到的线程首次写入（Linux首次访问时分配物理页），之后反复按块求和
+// nodes为内核节点号
+double NodeLocalScan(ThreadPool& pool, const std::vector<int>& nodes, size_t bytes_per_node, int rounds)
+{
+    const size_t count = bytes_per_node / sizeof(long long);
+    const size_t block = 32 * 1024;
+    // wait_until_empty只等队列为空，这里要等所有任务执行完
+    std::atomic<size_t> remaining{0};
+    auto wait_all = [&remaining]()
+    {
+        while (remaining.load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::yield();
+        }
+    };
+
+    std::vector<std::unique_ptr<long long[]>> buffers;
+    for (int node : nodes)
+    {
+        buffers.emplace_back(new long long[count]); // 不初始化，物理页在首次写入时分配
+        for (size_t begin = 0; begin < count; begin += block)
+        {
+            long long* data = buffers.back().get();
+            remaining.fetch_add(1, std::memory_order_relaxed);
+            pool.push_to_node(node, [data, begin, count, block, &remaining]()
+                              {
+                                  for (size_t i = begin; i < std::min(count, begin + block); ++i)
+                                  {
+                                      data[i] = static_cast<long long>(i & 7);
+                                  }
+                                  remaining.fetch_sub(1, std::memory_order_release);
+                              });
+        }
+    }
+    wait_all();
+
+    std::atomic<long long> total{0};
+    TimeCounter counter;
+    for (int round = 0; round < rounds; ++round)
+    {
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            const int node = nodes[i];
+            const long long* data = buffers[i].get();
+            for (size_t begin = 0; begin < count; begin += block)
+            {
+                remaining.fetch_add(1, std::memory_order_relaxed);
+                pool.push_to_node(node, [data, begin, count, block, &total, &remaining]()
+                                  {
+                                      long long sum = 0;
+                                      for (size_t i = begin; i < std::min(count, begin + block); ++i)
+                                      {
+                                          sum += data[i];
+                                      }
+                                      total.fetch_add(sum, std::memory_order_relaxed);
+                                      remaining.fetch_sub(1, std::memory_order_release);
+                                  });
+            }
+        }
+        wait_all();
+    }
+    return static_cast<double>(counter.elapsed_micro()) / 1000.0 / rounds;
+}
+
+int main()
+{
+    const NumaTopology topology = NumaTopology::detect();
+    std::cout << "NUMA nodes: " << topology.node_count() << "\n";
+    std::vector<int> node_ids;
+    for (const NumaTopology::Node& node : topology.nodes)
+    {
+        node_ids.push_back(node.id);
+        std::cout << "  node " << node.id << ": " << node.cpus.size() << " cpus (";
+        for (size_t i = 0; i < node.cpus.size(); ++i)
+        {
+            std::cout << (i ? "," : "") << node.cpus[i];
+        }
+        std::cout << ")\n";
+    }
+
+    const std::vector<int>& first = topology.nodes[0].cpus;
+    const bool has_pair = first.size() >= 2;
+    const bool has_remote = topology.node_count() >= 2;
+    const int local_peer = has_pair ? first[1] : first[0];
+    const int remote_peer = has_remote ? topology.nodes[1].cpus[0] : -1;
+    std::cout << std::fixed << std::setprecision(1);
+
+    // 1. 缓存行在两个核之间来回传递的代价
+    const int rounds = 200000;
+    std::cout << "\nCache line ping-pong, " << rounds << " round trips\n";
+    std::cout << "  unpinned            " << std::setw(10) << PingPong(-1, -1, rounds) << " ns/round trip\n";
+    if (has_pair)
+    {
+        std::cout << "  same node  (" << first[0] << "<->" << local_peer << ")   " << std::setw(10) << PingPong(first[0], local_peer, rounds) << " ns/round trip\n";
+    }
+    else
+    {
+        std::cout << "  same node           skipped (node 0 has a single cpu)\n";
+    }
+    if (has_remote)
+    {
+        std::cout << "  cross node (" << first[0] << "<->" << remote_peer << ")   " << std::setw(10) << PingPong(first[0], remote_peer, rounds) << " ns/round trip\n";
+    }
+    else
+    {
+        std::cout << "  cross node          skipped (single NUMA node)\n";
+    }
+
+    // 2. 绑定ThreadExecutor：与调用线程同节点 vs 跨节点
+    const int executor_rounds = 20000;
+    std::cout << "\nThreadExecutor::postAndWait, caller pinned to cpu " << first[0] << ", " << executor_rounds << " calls\n";
+    std::cout << "  executor unpinned   " << std::setw(10) << ExecutorRoundTrip(first[0], -1, executor_rounds) << " us/call\n";
+    std::cout << "  executor same node  " << std::setw(10) << ExecutorRoundTrip(first[0], local_peer, executor_rounds) << " us/call\n";
+    if (has_remote)
+    {
+        std::cout << "  executor cross node " << std::setw(10) << ExecutorRoundTrip(first[0], remote_peer, executor_rounds) << " us/call\n";
+    }
+
+    // 3. 每个节点一块数据：按节点分组后数据由本节点线程写入、读取；不绑定时任意线程访问任意节点的内存
+    const size_t threads = topology.all_cpus().size();
+    const size_t nodes = node_ids.size();
+    const size_t bytes_per_node = 64 * 1024 * 1024;
+    std::cout << "\nThreadPool (" << threads << " threads, work stealing), scan " << nodes << " x " << bytes_per_node / (1024 * 1024)
+              << " MB, one buffer per node\n";
+    const struct
+    {
+        const char* name;
+        ThreadPoolAffinity affinity;
+    } configs[] = {
+        {"None     ", ThreadPoolAffinity::None},
+        {"PinToCore", ThreadPoolAffinity::PinToCore},
+        {"NumaNode ", ThreadPoolAffinity::NumaNode},
+    };
+    for (const auto& config : configs)
+    {
+        ThreadPool pool(threads, ThreadPoolMode::WorkStealing, config.affinity);
+        std::cout << "  " << config.name << "  groups " << pool.numa_node_count() << "  "
+                  << std::setw(8) << NodeLocalScan(pool, node_ids, bytes_per_node, 10) << " ms/scan\n";
+    }
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,99 @@
+#include "DemoHead.h"
+
+#if T_ThreadPoolStatsDemo
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "TimeCounter.h"
+
+// 打印一个线程池的统计快照
+void PrintStats(const char* name, ThreadPool& pool)
+{
+    const ThreadPoolStats stats = pool.get_stats();
+    std::cout << name << ": threads " << stats.threads << ", pending " << stats.pending
+              << ", completed " << stats.tasks_completed << ", exceptions " << stats.exceptions
+              << ", utilization " << std::setprecision(1) << stats.Utilization() * 100 << "%\n"
+              << std::setprecision(2)
+              << "  queue wait  avg " << std::setw(9) << stats.queue_wait.AverageMicros() << " us"
+              << "  p50 " << std::setw(9) << stats.queue_wait.PercentileMicros(0.5) << " us"
+              << "  p99 " << std::setw(9) << stats.queue_wait.PercentileMicros(0.99) << " us"
+              << "  max " << std::setw(9) << stats.queue_wait.max_ns / 1000.0 << " us\n"
+              << "  run time    avg " << std::setw(9) << stats.run_time.AverageMicros() << " us"
+              << "  p50 " << std::setw(9) << stats.run_time.PercentileMicros(0.5) << " us"
+              << "  p99 " << std::setw(9) << stats.run_time.PercentileMicros(0.99) << " us"
+              << "  max " << std::setw(9) << stats.run_time.max_ns / 1000.0 << " us\n";
+
+    for (const ThreadPoolWorkerStats& worker : stats.workers)
+    {
+        std::cout << "  worker " << std::setw(2) << worker.id << "  tasks " << std::setw(7) << worker.tasks_completed
+                  << "  busy " << std::setw(5) << std::setprecision(1) << worker.Utilization() * 100 << "%"
+                  << "  queue wait p99 " << std::setw(9) << std::setprecision(2) << worker.queue_wait.PercentileMicros(0.99) << " us\n";
+    }
+}
+
+int main()
+{
+    std::cout << std::fixed;
+
+    // 两个线程池承受同样的请求速率：一个线程数不够（饱和），一个有余量
+    ThreadPool saturated(2);
+    ThreadPool healthy(8);
+
+    const auto begin = std::chrono::steady_clock::now();
+    for (int ms = 0; ms < 500; ++ms)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            auto request = []()
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(800)); // 模拟阻塞IO
+            };
+            saturated.push(request);
+            healthy.push(request);
+        }
+        std::this_thread::sleep_until(begin + std::chrono::milliseconds(ms + 1));
+    }
+
+    // push 提交的任务抛出的异常被线程池吞掉，只能从计数上看到（这里先关掉线程池打印的错误信息）
+    std::cerr.setstate(std::ios::failbit);
+    for (int i = 0; i < 5; ++i)
+    {
+        healthy.push([]() { throw std::runtime_error("lost"); });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::cerr.clear();
+    PrintStats("healthy pool  (8 threads)", healthy);
+    std::cout << "\n";
+    saturated.wait_until_empty();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    PrintStats("saturated pool (2 threads)", saturated);
+
+    // 统计的开销：每个任务两次读时钟、若干次无竞争的原子写
+    const size_t tasks = 1000000;
+    ThreadPool pool(4, ThreadPoolMode::WorkStealing);
+    std::atomic<size_t> counter{0};
+    TimeCounter timer;
+    pool.push([&pool, &counter, tasks]()
+              {
+                  for (size_t i = 0; i < tasks; ++i)
+                  {
+                      pool.push([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+                  }
+              });
+    while (counter.load() < tasks)
+    {
+        std::this_thread::yield();
+    }
+    const double ns_per_task = static_cast<double>(timer.elapsed_nano()) / tasks;
+    std::cout << "\n" << tasks << " tiny tasks (work stealing, 4 threads): " << std::setprecision(1) << ns_per_task << " ns/task with stats recorded\n";
+    PrintStats("tiny task pool", pool);
+
+    return 0;
+}
+
+#endif
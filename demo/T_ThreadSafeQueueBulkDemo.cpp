@@ -0,0 +1,144 @@
+#include "DemoHead.h"
+
+#if T_ThreadSafeQueueBulkDemo
+
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include "ThreadSafeQueue.hpp"
+#include "TimeCounter.h"
+
+// producers个生产者向容量为capacity的队列写入messages条消息后close()，consumers个消费者每次最多取batch条，返回吞吐量（百万条/秒）
+// batch为1时用wait_pop逐条取，否则用pop_bulk
+double Pipeline(size_t producers, size_t consumers, size_t capacity, size_t messages, size_t batch)
+{
+    ThreadSafeQueue<int64_t> queue(capacity);
+    std::vector<std::thread> consumer_threads;
+    std::vector<int64_t> sums(consumers, 0);
+
+    TimeCounter counter;
+    for (size_t c = 0; c < consumers; ++c)
+    {
+        consumer_threads.emplace_back([&queue, &sums, c, batch]()
+                                      {
+                                          int64_t sum = 0;
+                                          std::vector<int64_t> items;
+                                          items.reserve(batch);
+                                          while (true)
+                                          {
+                                              if (batch == 1)
+                                              {
+                                                  auto item = queue.wait_pop(std::chrono::seconds(10));
+                                                  if (!item)
+                                                  {
+                                                      break; // 已关闭且取空
+                                                  }
+                                                  sum += *item;
+                                                  continue;
+                                              }
+
+                                              items.clear();
+                                              if (queue.pop_bulk(std::back_inserter(items), batch, std::chrono::seconds(10)) == 0)
+                                              {
+                                                  break;
+                                              }
+                                              for (int64_t item : items)
+                                              {
+                                                  sum += item;
+                                              }
+                                          }
+                                          sums[c] = sum;
+                                      });
+    }
+
+    std::vector<std::thread> producer_threads;
+    for (size_t p = 0; p < producers; ++p)
+    {
+        producer_threads.emplace_back([&queue, messages, producers]()
+                                      {
+                                          for (size_t i = 0; i < messages / producers; ++i)
+                                          {
+                                              queue.push(static_cast<int64_t>(i));
+                                          }
+                                      });
+    }
+    for (auto& thread : producer_threads)
+    {
+        thread.join();
+    }
+
+    // 关闭后消费者取完剩余消息即退出，不需要为每个消费者发送结束标记
+    queue.close();
+    for (auto& thread : consumer_threads)
+    {
+        thread.join();
+    }
+    const double seconds = counter.elapsed_micro() / 1e6;
+
+    int64_t total = 0;
+    for (int64_t sum : sums)
+    {
+        total += sum;
+    }
+    const int64_t per_producer = static_cast<int64_t>(messages / producers);
+    const int64_t expected = static_cast<int64_t>(producers) * (per_producer * (per_producer - 1) / 2);
+    if (total != expected)
+    {
+        std::cout << "checksum mismatch: " << total << " != " << expected << "\n";
+    }
+
+    return messages / seconds / 1e6;
+}
+
+int main()
+{
+    const size_t messages = 2000000;
+    std::cout << std::fixed << std::setprecision(2);
+
+    // 1. 有界队列：生产者比消费者快，生产者会阻塞在满队列上，出队必须唤醒它们
+    std::cout << "Bounded queue (capacity 64), 4 producers x 1 consumer, wait_pop: "
+              << Pipeline(4, 1, 64, messages, 1) << " Mmsg/s\n";
+
+    // 2. 批量出队：一次加锁取走多条，摊薄锁的开销
+    std::cout << "\nConsumer batch size, capacity 4096 (Mmsg/s)\n";
+    std::cout << std::setw(10) << "batch" << std::setw(12) << "1P x 1C" << std::setw(12) << "4P x 4C" << "\n";
+    for (size_t batch : {1, 16, 128, 512})
+    {
+        std::cout << std::setw(10) << batch
+                  << std::setw(12) << Pipeline(1, 1, 4096, messages, batch)
+                  << std::setw(12) << Pipeline(4, 4, 4096, messages, batch) << "\n";
+    }
+
+    // 3. drain：与内部容器交换，一次取走全部
+    ThreadSafeQueue<int> queue;
+    for (int i = 0; i < 100000; ++i)
+    {
+        queue.push(i);
+    }
+    TimeCounter counter;
+    const auto items = queue.drain();
+    std::cout << "\ndrain() of " << items.size() << " items: " << counter.elapsed_micro() << " us, queue size after: " << queue.size() << "\n";
+
+    // 4. try_push超时：队列满且没有消费者时按时返回
+    ThreadSafeQueue<int> full(1);
+    full.push(0);
+    counter.reset();
+    const bool pushed = full.try_push(1, std::chrono::milliseconds(50));
+    std::cout << "try_push on full queue with 50 ms timeout: " << (pushed ? "pushed" : "timed out") << " after " << counter.elapsed_milli() << " ms\n";
+
+    // 5. close()唤醒阻塞的生产者
+    std::thread blocked([&full]()
+                        {
+                            const bool ok = full.push(2);
+                            std::cout << "blocked push returned " << (ok ? "true" : "false") << " after close()\n";
+                        });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    full.close();
+    blocked.join();
+
+    return 0;
+}
+
+#endif
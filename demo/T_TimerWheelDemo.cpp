@@ -0,0 +1,100 @@
+#include "DemoHead.h"
+
+#if T_TimerWheelDemo
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include "TimerWheel.hpp"
+#include "TimeCounter.h"
+
+int main()
+{
+    const size_t timer_count = 1000000;
+    TimerWheel wheel;
+    std::mt19937 rng(42);
+
+    // 1. 一百万个长延时定时器：添加与取消的开销
+    {
+        std::uniform_int_distribution<int> delay(1000, 600000);
+        std::vector<TimerWheel::TimerId> ids(timer_count);
+
+        TimeCounter counter;
+        for (auto& id : ids)
+        {
+            id = wheel.schedule_after(std::chrono::milliseconds(delay(rng)), []() {});
+        }
+        const int64_t schedule_us = counter.elapsed_micro();
+        const size_t live = wheel.size();
+
+        std::shuffle(ids.begin(), ids.end(), rng);
+        counter.reset();
+        size_t cancelled = 0;
+        for (auto id : ids)
+        {
+            cancelled += wheel.cancel(id) ? 1 : 0;
+        }
+        const int64_t cancel_us = counter.elapsed_micro();
+
+        std::cout << "1M timers: schedule " << std::fixed << std::setprecision(1) << schedule_us * 1000.0 / timer_count << " ns/op"
+                  << ", cancel " << cancel_us * 1000.0 / timer_count << " ns/op"
+                  << " (live " << live << ", cancelled " << cancelled << ")\n";
+    }
+
+    // 2. 一百万个定时器在2秒内陆续到期：统计触发延迟
+    {
+        std::uniform_int_distribution<int> delay(0, 2000);
+        std::atomic<size_t> fired{0};
+        std::atomic<int64_t> total_late_us{0};
+        std::atomic<int64_t> max_late_us{0};
+
+        for (size_t i = 0; i < timer_count; ++i)
+        {
+            const auto expected = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay(rng));
+            const int ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(expected - std::chrono::steady_clock::now()).count());
+            wheel.schedule_after(std::chrono::milliseconds(ms), [&, expected]()
+                                 {
+                                     const int64_t late = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - expected).count();
+                                     total_late_us.fetch_add(late, std::memory_order_relaxed);
+                                     int64_t current = max_late_us.load(std::memory_order_relaxed);
+                                     while (late > current && !max_late_us.compare_exchange_weak(current, late))
+                                     {
+                                     }
+                                     fired.fetch_add(1, std::memory_order_release);
+                                 });
+        }
+
+        while (fired.load() < timer_count)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+
+        std::cout << "1M timers fired: average lateness " << total_late_us.load() / 1000.0 / timer_count << " ms"
+                  << ", max " << max_late_us.load() / 1000.0 << " ms\n";
+    }
+
+    // 3. 周期定时器投递到线程池
+    {
+        ThreadPool pool(4);
+        std::atomic<size_t> runs{0};
+        std::vector<TimerWheel::TimerId> ids;
+        for (int i = 0; i < 1000; ++i)
+        {
+            ids.push_back(wheel.schedule_every(std::chrono::milliseconds(10), [&runs]() { runs.fetch_add(1, std::memory_order_relaxed); }, pool));
+        }
+
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        for (auto id : ids)
+        {
+            wheel.cancel(id);
+        }
+        pool.wait_until_empty();
+
+        std::cout << "1000 periodic 10ms timers on ThreadPool for 1s: " << runs.load() << " runs (expected ~100000)\n";
+    }
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include "DemoHead.h"
+
+#if T_WorkStealingDemo
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <thread>
+#include "ThreadPool.hpp"
+#include "TimeCounter.h"
+
+// 细粒度任务：几百纳秒的计算量，调度开销占主导
+inline uint64_t SpinWork(uint64_t seed)
+{
+    for (int i = 0; i < 64; ++i)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    return seed;
+}
+
+// 外部线程提交大量细粒度任务
+double FlatBenchmark(ThreadPoolMode mode, size_t thread_count, size_t task_count)
+{
+    std::atomic<uint64_t> checksum{0};
+    TimeCounter counter;
+    {
+        ThreadPool pool(thread_count, mode);
+        for (size_t i = 0; i < task_count; ++i)
+        {
+            pool.push([&checksum, i]()
+                      {
+                          checksum.fetch_add(SpinWork(i) & 1, std::memory_order_relaxed);
+                      });
+        }
+        pool.wait_until_empty();
+    }   // 析构时等待剩余任务执行完
+
+    const double seconds = counter.elapsed_micro() / 1e6;
+    return task_count / seconds / 1e6;
+}
+
+// 递归分叉：任务在工作线程内继续提交子任务，工作窃取模式下子任务进入本地队列
+void Fork(ThreadPool& pool, std::atomic<size_t>& remaining, uint64_t seed, int depth)
+{
+    if (depth > 0)
+    {
+        pool.push([&pool, &remaining, seed, depth]() { Fork(pool, remaining, seed * 2, depth - 1); });
+        pool.push([&pool, &remaining, seed, depth]() { Fork(pool, remaining, seed * 2 + 1, depth - 1); });
+    }
+
+    SpinWork(seed);
+    remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+double ForkBenchmark(ThreadPoolMode mode, size_t thread_count, int depth)
+{
+    const size_t task_count = (size_t(1) << (depth + 1)) - 1;
+    std::atomic<size_t> remaining{task_count};
+
+    ThreadPool pool(thread_count, mode);
+    TimeCounter counter;
+    pool.push([&pool, &remaining, depth]() { Fork(pool, remaining, 1, depth); });
+    while (remaining.load(std::memory_order_acquire) != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    const double seconds = counter.elapsed_micro() / 1e6;
+    return task_count / seconds / 1e6;
+}
+
+int main()
+{
+    const size_t flat_tasks = 200000;
+    const int fork_depth = 17;  // 约26万个任务
+
+    std::cout << "ThreadPool fine-grained task throughput (Mtasks/s, higher is better)\n";
+    std::cout << std::setw(10) << "threads"
+              << std::setw(14) << "flat shared" << std::setw(14) << "flat steal"
+              << std::setw(14) << "fork shared" << std::setw(14) << "fork steal" << "\n";
+
+    for (size_t thread_count : {1, 2, 4, 8, 16, 32, 64})
+    {
+        const double flat_shared = FlatBenchmark(ThreadPoolMode::SharedQueue, thread_count, flat_tasks);
+        const double flat_steal = FlatBenchmark(ThreadPoolMode::WorkStealing, thread_count, flat_tasks);
+        const double fork_shared = ForkBenchmark(ThreadPoolMode::SharedQueue, thread_count, fork_depth);
+        const double fork_steal = ForkBenchmark(ThreadPoolMode::WorkStealing, thread_count, fork_depth);
+
+        std::cout << std::setw(10) << thread_count << std::fixed << std::setprecision(2)
+                  << std::setw(14) << flat_shared << std::setw(14) << flat_steal
+                  << std::setw(14) << fork_shared << std::setw(14) << fork_steal << "\n";
+    }
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// chunk内存来源策略
+// MemoryPool每次扩展时通过它申请一整块连续内存（chunk），收缩或析构时再交还
+// 实现必须线程安全，且生命周期必须长于使用它的所有内存池
+class ChunkProvider
+{
+public:
+    virtual ~ChunkProvider() = default;
+
+    // 申请一个chunk
+    // size: 字节数（已经过GoodSize取整）
+    // alignment: 对齐要求
+    virtual void* Allocate(size_t size, size_t alignment) = 0;
+
+    // 归还chunk，size和alignment必须与申请时一致
+    virtual void Deallocate(void* chunk, size_t size, size_t alignment) = 0;
+
+    // 不浪费内存的chunk大小（不小于size），内存池据此调整每个chunk的块数
+    virtual size_t GoodSize(size_t size) const
+    {
+        return size;
+    }
+};
+
+// 默认策略：从全局堆申请
+class HeapChunkProvider : public ChunkProvider
+{
+public:
+    // 全局默认实例（永不析构，保证静态内存池析构时仍可使用）
+    static HeapChunkProvider* Default()
+    {
+        static HeapChunkProvider* instance = new HeapChunkProvider();
+        return instance;
+    }
+
+    void* Allocate(size_t size, size_t alignment) override
+    {
+        return operator new(size, std::align_val_t(alignment));
+    }
+
+    void Deallocate(void* chunk, size_t, size_t alignment) override
+    {
+        operator delete(chunk, std::align_val_t(alignment));
+    }
+};
+
+// 大页 + NUMA本地化策略（仅Linux生效，其他平台退化为全局堆）
+// 1. 优先用mmap(MAP_HUGETLB)从预留的大页池映射，失败时映射普通页并用madvise(MADV_HUGEPAGE)提示透明大页
+// 2. 映射后、首次写入前用mbind把物理页绑定到调用线程所在的NUMA节点
+// chunk大小会被取整到大页大小（2MB），适合块数较多的大内存池
+class HugePageChunkProvider : public ChunkProvider
+{
+public:
+    static constexpr size_t kHugePageSize = 2 * 1024 * 1024;  // x86-64/AArch64默认大页大小
+
+    // use_hugetlb: 是否尝试预留大页（需要系统配置vm.nr_hugepages）
+    // bind_local_node: 是否把chunk绑定到调用线程所在的NUMA节点
+    explicit HugePageChunkProvider(bool use_hugetlb = true, bool bind_local_node = true)
+        : use_hugetlb_(use_hugetlb), bind_local_node_(bind_local_node) {}
+
+    // 全局默认实例
+    static HugePageChunkProvider* Default()
+    {
+        static HugePageChunkProvider* instance = new HugePageChunkProvider();
+        return instance;
+    }
+
+    size_t GoodSize(size_t size) const override
+    {
+        return RoundUp(size, kHugePageSize);
+    }
+
+    void* Allocate(size_t size, size_t alignment) override
+    {
+#if defined(__linux__)
+        const size_t length = RoundUp(size, kHugePageSize);
+        void* chunk = nullptr;
+
+        // 1. 预留大页
+        if (use_hugetlb_)
+        {
+            chunk = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (chunk == MAP_FAILED)
+            {
+                chunk = nullptr;
+            }
+            else
+            {
+                hugetlb_chunks_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // 2. 普通页 + 透明大页提示：多映射一个大页，裁掉首尾使起始地址按大页对齐，才能被内核折叠成大页
+        if (!chunk)
+        {
+            void* raw = mmap(nullptr, length + kHugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED)
+            {
+                throw std::bad_alloc();
+            }
+
+            const uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+            const uintptr_t aligned = RoundUp(begin, kHugePageSize);
+            if (aligned > begin)
+            {
+                munmap(raw, aligned - begin);
+            }
+            const size_t tail = kHugePageSize - (aligned - begin);
+            if (tail > 0)
+            {
+                munmap(reinterpret_cast<void*>(aligned + length), tail);
+            }
+
+            chunk = reinterpret_cast<void*>(aligned);
+            if (madvise(chunk, length, MADV_HUGEPAGE) == 0)
+            {
+                thp_chunks_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        // 3. 绑定NUMA节点（失败时保持内核默认的首次访问策略）
+        if (bind_local_node_)
+        {
+            BindToLocalNode(chunk, length);
+        }
+
+        (void)alignment;  // 大页对齐满足任何块对齐要求
+        return chunk;
+#else
+        return HeapChunkProvider::Default()->Allocate(size, alignment);
+#endif
+    }
+
+    void Deallocate(void* chunk, size_t size, size_t alignment) override
+    {
+#if defined(__linux__)
+        (void)alignment;
+        munmap(chunk, RoundUp(size, kHugePageSize));
+#else
+        HeapChunkProvider::Default()->Deallocate(chunk, size, alignment);
+#endif
+    }
+
+    // 成功使用预留大页的chunk数
+    size_t GetHugeTlbChunks() const
+    {
+        return hugetlb_chunks_.load(std::memory_order_relaxed);
+    }
+
+    // 退化为透明大页提示的chunk数
+    size_t GetTransparentChunks() const
+    {
+        return thp_chunks_.load(std::memory_order_relaxed);
+    }
+
+    // 成功绑定NUMA节点的chunk数
+    size_t GetNumaBoundChunks() const
+    {
+        return numa_bound_chunks_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t RoundUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+#if defined(__linux__)
+    // 直接走系统调用，避免依赖libnuma
+    void BindToLocalNode(void* chunk, size_t length)
+    {
+        unsigned cpu = 0;
+        unsigned node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+        {
+            return;
+        }
+
+        // MPOL_PREFERRED：优先本节点，本节点内存不足时仍可回落到其他节点，不会因此触发OOM
+        constexpr int kMpolPreferred = 1;
+        constexpr size_t kMaskBits = sizeof(unsigned long) * 8;
+        unsigned long node_mask[4] = {};
+        if (node >= kMaskBits * 4)
+        {
+            return;
+        }
+        node_mask[node / kMaskBits] = 1UL << (node % kMaskBits);
+
+        if (syscall(SYS_mbind, chunk, length, kMpolPreferred, node_mask, kMaskBits * 4 + 1, 0) == 0)
+        {
+            numa_bound_chunks_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+#endif
+
+    bool use_hugetlb_;                          // 是否尝试预留大页
+    bool bind_local_node_;                      // 是否绑定本地NUMA节点
+    std::atomic<size_t> hugetlb_chunks_{0};     // 预留大页chunk数
+    std::atomic<size_t> thp_chunks_{0};         // 透明大页chunk数
+    std::atomic<size_t> numa_bound_chunks_{0};  // 已绑定NUMA节点的chunk数
+};
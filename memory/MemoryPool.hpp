@@ -1,11 +1,19 @@
 #pragma once
 
 #include <mutex>
+#include <algorithm>
 #include <vector>
 #include <cstddef>
 #include <iostream>
 #include <atomic>
 #include <thread>
+#include <memory>
+#include <unordered_map>
+#include <new>
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include "ChunkProvider.hpp"
 
 // 内存池调试模式开关
 // #define MEMORY_POOL_DEBUG
@@ -28,6 +36,39 @@ std::lock_guard<std::mutex> log_lock(log_mutex_); \
         size_t total_chunks = 0;            // 内存块数量
         size_t total_memory = 0;            // 总内存占用(bytes)
         size_t thread_cache_blocks = 0;     // 线程缓存块数
+        size_t thread_cache_capacity = 0;   // 所有线程缓存的有效容量之和
+        std::vector<size_t> thread_cache_capacities;  // 各线程缓存的有效容量
+        size_t peak_in_use_blocks = 0;      // 峰值占用块数（已分配+线程缓存，在访问中央池时采样）
+
+        // 累计计数（含已退出线程）
+        uint64_t allocations = 0;           // 分配次数
+        uint64_t deallocations = 0;         // 回收次数
+        uint64_t refills = 0;               // 线程缓存补充次数（缓存为空）
+        uint64_t returns = 0;               // 线程缓存归还次数（缓存已满）
+        uint64_t central_lock_waits = 0;    // 中央池锁发生竞争的次数
+        uint64_t central_lock_wait_ns = 0;  // 中央池锁竞争的累计等待时间(ns)
+
+        std::chrono::steady_clock::time_point timestamp;  // 采样时间
+
+        // 自earlier采样以来每秒分配次数
+        double AllocationsPerSecond(const MemoryStats& earlier) const
+        {
+            return RatePerSecond(allocations - earlier.allocations, earlier);
+        }
+
+        // 自earlier采样以来每秒回收次数
+        double DeallocationsPerSecond(const MemoryStats& earlier) const
+        {
+            return RatePerSecond(deallocations - earlier.deallocations, earlier);
+        }
+
+        // 自earlier采样以来的线程缓存未命中率（补充+归还次数 / 分配+回收次数）
+        double CacheMissRatio(const MemoryStats& earlier) const
+        {
+            const uint64_t operations = (allocations - earlier.allocations) + (deallocations - earlier.deallocations);
+            const uint64_t misses = (refills - earlier.refills) + (returns - earlier.returns);
+            return operations ? static_cast<double>(misses) / operations : 0.0;
+        }
 
         // 打印内存统计信息
         void Print() const
@@ -36,11 +77,51 @@ std::lock_guard<std::mutex> log_lock(log_mutex_); \
                       << "  Allocated Blocks: " << allocated_blocks << "\n"
                       << "  Free Blocks: " << free_blocks << "\n"
                       << "  Thread Cache Blocks: " << thread_cache_blocks << "\n"
+                      << "  Thread Cache Capacity: " << thread_cache_capacity << " (";
+            for (size_t i = 0; i < thread_cache_capacities.size(); ++i)
+            {
+                std::cout << (i ? " " : "") << thread_cache_capacities[i];
+            }
+            std::cout << ")\n"
+                      << "  Peak In-Use Blocks: " << peak_in_use_blocks << "\n"
+                      << "  Allocations/Deallocations: " << allocations << "/" << deallocations << "\n"
+                      << "  Refills/Returns: " << refills << "/" << returns << "\n"
+                      << "  Central Lock Waits: " << central_lock_waits << " (" << central_lock_wait_ns / 1000 << " us)\n"
                       << "  Total Chunks: " << total_chunks << "\n"
                       << "  Total Memory: " << total_memory / 1024 << " KB\n";
         }
+
+    private:
+        double RatePerSecond(uint64_t count, const MemoryStats& earlier) const
+        {
+            const double seconds = std::chrono::duration<double>(timestamp - earlier.timestamp).count();
+            return seconds > 0 ? count / seconds : 0.0;
+        }
     };
 
+// 中央空闲链表的实现方式
+enum class CentralListMode
+{
+    Mutex,      // 互斥锁保护的单链表，按块逐个移动
+    LockFree    // 带标签的无锁栈，元素是预先链好的整批内存块，补充/归还一次CAS完成
+};
+
+// 内存池配置
+struct MemoryPoolConfig
+{
+    size_t alignment = alignof(std::max_align_t);       // 内存对齐要求
+    size_t thread_cache_size = 32;                      // 每个线程本地缓存的内存块数量（无锁模式下也是每批的块数）
+    size_t chunk_block_count = 256;                     // 每次扩展时分配的内存块数量
+    CentralListMode central_mode = CentralListMode::Mutex;  // 中央空闲链表实现方式
+    ChunkProvider* chunk_provider = nullptr;            // chunk内存来源，为空时使用全局堆（需长于内存池存活）
+
+    // 线程缓存自适应：频繁未命中的线程扩容，空闲的线程缩容；上下限相同（默认）时缓存大小固定
+    size_t min_thread_cache_size = 0;                   // 缓存容量下限，0表示与thread_cache_size相同
+    size_t max_thread_cache_size = 0;                   // 缓存容量上限，0表示与thread_cache_size相同
+    size_t global_cache_limit = 0;                      // 所有线程缓存容量之和的上限，0表示不限制
+    std::chrono::milliseconds cache_idle_interval{1000};  // 两次未命中间隔超过该值视为空闲，容量减半
+};
+
 // 内存池类，提供固定大小的内存块分配和回收
 class MemoryPool
 {
@@ -51,48 +132,106 @@ public:
     // thread_cache_size: 每个线程本地缓存的内存块数量
     // chunk_block_count: 每次扩展时分配的内存块数量
     explicit MemoryPool(size_t block_size, size_t alignment = alignof(std::max_align_t), size_t thread_cache_size = 32, size_t chunk_block_count = 256)
-        : alignment_(alignment),block_size_(CalculateAlignedSize(block_size, alignment)),chunk_block_count_(chunk_block_count),thread_cache_size_(thread_cache_size)
+        : MemoryPool(block_size, MemoryPoolConfig{alignment, thread_cache_size, chunk_block_count})
     {
+    }
+
+    // 构造函数
+    // block_size: 每个内存块的大小
+    // config: 内存池配置
+    MemoryPool(size_t block_size, const MemoryPoolConfig& config)
+        : id_(RegisterPool(this)),
+          central_mode_(config.central_mode),
+          alignment_(std::max(config.alignment, alignof(Node))),
+          block_size_(CalculateAlignedSize(std::max(block_size, MinBlockSize(config.central_mode)), alignment_)),
+          chunk_block_count_(std::max<size_t>(config.chunk_block_count, 1)),
+          thread_cache_size_(std::max<size_t>(config.thread_cache_size, 1)),
+          chunk_provider_(config.chunk_provider ? config.chunk_provider : HeapChunkProvider::Default()),
+          min_cache_capacity_(config.min_thread_cache_size ? config.min_thread_cache_size : thread_cache_size_),
+          max_cache_capacity_(std::max(config.max_thread_cache_size ? config.max_thread_cache_size : thread_cache_size_, min_cache_capacity_)),
+          global_cache_limit_(config.global_cache_limit),
+          cache_idle_interval_(config.cache_idle_interval)
+    {
+        // 按来源的取整粒度（如大页）补足每个chunk的块数，避免尾部浪费
+        chunk_block_count_ = chunk_provider_->GoodSize(block_size_ * chunk_block_count_) / block_size_;
+
+        std::lock_guard<std::mutex> lock(central_mutex_);
         Expand();  // 初始化时先扩展一次内存池
     }
 
     // 析构函数，释放所有内存
     ~MemoryPool()
     {
-        ShrinkToFit(0);  // 释放所有内存
+        // 先注销，之后退出的线程不会再向本池归还缓存
+        UnregisterPool(id_);
+
+        // 当前线程的缓存直接丢弃，其他线程缓存表中残留的条目按池ID失效，不会再被访问
+        if (ThreadCacheTable* table = LocalTable())
+        {
+            table->Remove(id_);
+        }
+        {
+            std::lock_guard<std::mutex> lock(caches_mutex_);
+            thread_caches_.clear();
+        }
+
 #ifdef MEMORY_POOL_DEBUG
         auto stats = GetStats();
         std::cout << "\nMemoryPool Destruction Stats:\n";
         stats.Print();
 #endif
+
+        // 释放所有内存（此时仍未归还的块属于使用方泄漏）
+        std::lock_guard<std::mutex> lock(central_mutex_);
+        for (void* chunk : chunks_)
+        {
+            chunk_provider_->Deallocate(chunk, block_size_ * chunk_block_count_, alignment_);
+        }
+        chunks_.clear();
+        chunk_count_.store(0, std::memory_order_relaxed);
     }
 
     // 分配一个内存块
     void* Allocate()
     {
-        // 优先从线程本地缓存分配
-        if (!local_cache_.empty())
+        ThreadCache* cache = LocalCache();
+        if (!cache)
         {
-            void* ptr = local_cache_.back();
-            local_cache_.pop_back();
-#ifdef MEMORY_POOL_DEBUG
-            ++alloc_count_;
-#endif
+            shared_counters_.allocations.fetch_add(1, std::memory_order_relaxed);
+            void* ptr = AllocateFromCentral();
+            UpdatePeakInUse();
             return ptr;
         }
 
-        // 本地缓存为空，从中央池补充
-        RefillLocalCache();
+        // 有未响应的回收请求时先归还整个缓存
+        if (cache->seen_epoch != reclaim_epoch_.load(std::memory_order_relaxed))
+        {
+            AcknowledgeReclaim(*cache);
+        }
+
+        std::vector<void*>& local_cache = cache->blocks;
 
-        if (!local_cache_.empty())
+        // 本地缓存为空，调整容量后从中央池补充
+        if (local_cache.empty())
         {
-            void* ptr = local_cache_.back();
-            local_cache_.pop_back();
-            return ptr;
+            Bump(cache->counters.refills);
+            AdaptCapacity(*cache);
+            RefillLocalCache(local_cache, cache->capacity.load(std::memory_order_relaxed));
+            UpdatePeakInUse();
+
+            // 中央池也无可用内存（理论上不会发生）
+            if (local_cache.empty())
+            {
+                throw std::bad_alloc();
+            }
         }
 
-        // 中央池也无可用内存（理论上不会发生）
-        throw std::bad_alloc();
+        // 从线程本地缓存分配
+        void* ptr = local_cache.back();
+        local_cache.pop_back();
+        cache->cached_blocks.store(local_cache.size(), std::memory_order_relaxed);
+        Bump(cache->counters.allocations);
+        return ptr;
     }
 
     // 回收一个内存块
@@ -100,88 +239,195 @@ public:
     {
         if (!ptr) return;
 
-        // 如果有全局回收请求，直接归还到中央池
-        if (memory_reclaim_requested_.load(std::memory_order_acquire))
+        ThreadCache* cache = LocalCache();
+        if (!cache)
         {
-            std::lock_guard<std::mutex> lock(central_mutex_);
-            Node* node = static_cast<Node*>(ptr);
-            node->next = free_list_;
-            free_list_ = node;
-            ++free_blocks_;
-            POOL_LOG("Thread " << std::this_thread::get_id() << " returned block due to reclaim request");
+            shared_counters_.deallocations.fetch_add(1, std::memory_order_relaxed);
+            DeallocateToCentral(ptr);
             return;
         }
 
-        // 优先放入线程本地缓存
-        if (local_cache_.size() < thread_cache_size_)
+        // 有未响应的回收请求时先归还整个缓存
+        if (cache->seen_epoch != reclaim_epoch_.load(std::memory_order_relaxed))
         {
-            local_cache_.push_back(ptr);
-            return;
+            AcknowledgeReclaim(*cache);
+        }
+
+        std::vector<void*>& local_cache = cache->blocks;
+
+        // 本地缓存已满，先尝试扩容，仍然放不下时批量归还中央池
+        if (local_cache.size() >= cache->capacity.load(std::memory_order_relaxed))
+        {
+            AdaptCapacity(*cache);
+            if (local_cache.size() >= cache->capacity.load(std::memory_order_relaxed))
+            {
+                Bump(cache->counters.returns);
+                ReturnLocalCache(local_cache);
+            }
         }
 
-        // 本地缓存已满，批量归还中央池
-        ReturnLocalCache();
-        local_cache_.push_back(ptr);
+        // 放入线程本地缓存
+        local_cache.push_back(ptr);
+        cache->cached_blocks.store(local_cache.size(), std::memory_order_relaxed);
+        Bump(cache->counters.deallocations);
     }
 
-    // 释放多余的空闲内存
-    // min_free_blocks: 需要保留的最小空闲块数
-    void ShrinkToFit(size_t min_free_blocks = 64)
+    // 批量分配内存块
+    // count: 需要的块数
+    // blocks: 输出数组，至少容纳count个指针
+    // 先取本线程缓存，不足部分在一次加锁（或若干次CAS）内从中央池整段取走，失败时抛出std::bad_alloc且不占用任何块
+    void AllocateBatch(size_t count, void** blocks)
     {
-        // 首先收集所有可用空闲块
-        CollectFreeBlocks();
+        if (count == 0) return;
 
-        std::lock_guard<std::mutex> lock(central_mutex_);
+        ThreadCache* cache = LocalCache();
+        size_t filled = 0;
+        if (cache)
+        {
+            if (cache->seen_epoch != reclaim_epoch_.load(std::memory_order_relaxed))
+            {
+                AcknowledgeReclaim(*cache);
+            }
+
+            std::vector<void*>& local_cache = cache->blocks;
+            const size_t take = std::min(count, local_cache.size());
+            std::copy(local_cache.end() - take, local_cache.end(), blocks);
+            local_cache.resize(local_cache.size() - take);
+            filled = take;
+        }
 
-        // 计算需要保留的空闲块
-        const size_t target_free = min_free_blocks;
-        if (free_blocks_ <= target_free)
+        try
         {
-            return;
+            if (filled < count)
+            {
+                TakeFromCentral(blocks + filled, count - filled, cache ? &cache->blocks : nullptr,
+                                cache ? cache->capacity.load(std::memory_order_relaxed) : 0);
+                UpdatePeakInUse();
+            }
+        }
+        catch (...)
+        {
+            DeallocateBatch(blocks, filled);
+            throw;
         }
 
-        // 释放多余的内存块
-        size_t blocks_to_free = free_blocks_ - target_free;
-        size_t chunks_to_free = (blocks_to_free + chunk_block_count_ - 1) / chunk_block_count_;
-        chunks_to_free = std::min(chunks_to_free, chunks_.size());
+        if (cache)
+        {
+            cache->cached_blocks.store(cache->blocks.size(), std::memory_order_relaxed);
+            Bump(cache->counters.allocations, count);
+            if (filled < count)
+            {
+                Bump(cache->counters.refills);
+            }
+        }
+        else
+        {
+            shared_counters_.allocations.fetch_add(count, std::memory_order_relaxed);
+        }
+    }
 
-        POOL_LOG("Shrinking: freeing " << chunks_to_free << " chunks");
+    // 批量回收内存块
+    // 先填满本线程缓存，其余在一次加锁（或一次CAS）内整段归还中央池
+    void DeallocateBatch(void* const* blocks, size_t count)
+    {
+        if (count == 0) return;
 
-        for (size_t i = 0; i < chunks_to_free; ++i)
+        ThreadCache* cache = LocalCache();
+        if (!cache)
         {
-            if (!chunks_.empty())
-            {
-                void* chunk = chunks_.back();
-                chunks_.pop_back();
-                operator delete(chunk);
+            shared_counters_.deallocations.fetch_add(count, std::memory_order_relaxed);
+            ReturnToCentral(blocks, count);
+            return;
+        }
 
-                free_blocks_ = (free_blocks_ > chunk_block_count_) ? free_blocks_ - chunk_block_count_ : 0;
-            }
+        if (cache->seen_epoch != reclaim_epoch_.load(std::memory_order_relaxed))
+        {
+            AcknowledgeReclaim(*cache);
         }
 
-        // 重建空闲链表
-        RebuildFreeList();
+        std::vector<void*>& local_cache = cache->blocks;
+        const size_t capacity = cache->capacity.load(std::memory_order_relaxed);
+        const size_t keep = std::min(count, capacity - std::min(capacity, local_cache.size()));
+        local_cache.insert(local_cache.end(), blocks, blocks + keep);
+        if (keep < count)
+        {
+            Bump(cache->counters.returns);
+            ReturnToCentral(blocks + keep, count - keep);
+        }
+        cache->cached_blocks.store(local_cache.size(), std::memory_order_relaxed);
+        Bump(cache->counters.deallocations, count);
+    }
+
+    // 释放完全空闲的内存块（chunk），仍有块在使用或缓存中的chunk不会被释放
+    // min_free_blocks: 需要保留的最小空闲块数
+    // handshake_timeout: 等待其他线程响应回收请求、归还缓存的最长时间
+    // 返回释放的chunk数量
+    size_t ShrinkToFit(size_t min_free_blocks = 64, std::chrono::milliseconds handshake_timeout = std::chrono::milliseconds(10))
+    {
+        // 1. 通知所有线程归还缓存，等待确认（空闲线程的空缓存无需确认）
+        RequestOtherThreadsReturn(handshake_timeout);
+
+        std::lock_guard<std::mutex> lock(central_mutex_);
+
+        // 2. 摘下中央空闲链表
+        size_t free_count = 0;
+        Node* free_list = DetachCentralFreeList(free_count);
+
+        // 3. 统计每个chunk的空闲块数，释放完全空闲的chunk
+        const size_t released = ReleaseFreeChunks(free_list, free_count, min_free_blocks);
+
+        // 4. 剩余空闲块放回中央空闲链表
+        AttachCentralFreeList(free_list, free_count);
+
+        POOL_LOG("Shrinking: released " << released << " chunks, " << free_count << " free blocks kept");
+        return released;
     }
 
     // 获取内存统计信息
+    // 不加中央池锁，分配/回收可以与统计并发进行；各项计数分别读取，彼此之间可能有微小偏差
     MemoryStats GetStats() const
     {
         MemoryStats stats;
+        stats.timestamp = std::chrono::steady_clock::now();
+
+        const size_t chunks = chunk_count_.load(std::memory_order_relaxed);
+        const size_t free_blocks = free_blocks_.load(std::memory_order_relaxed);
+        const size_t total_blocks = chunk_block_count_ * chunks;
+
+        // 无锁模式下计数在CAS之后才更新，可能短暂偏大
+        stats.allocated_blocks = total_blocks > free_blocks ? total_blocks - free_blocks : 0;
+        stats.free_blocks = free_blocks;
+        stats.total_chunks = chunks;
+        stats.total_memory = chunks * block_size_ * chunk_block_count_;
+        stats.peak_in_use_blocks = peak_in_use_.load(std::memory_order_relaxed);
+        stats.central_lock_waits = lock_waits_.load(std::memory_order_relaxed);
+        stats.central_lock_wait_ns = lock_wait_ns_.load(std::memory_order_relaxed);
+
+        // 线程本地缓存统计（各线程最近一次分配/回收后的缓存块数），caches_mutex_只在线程登记/退出时争用
         {
-            std::lock_guard<std::mutex> lock(central_mutex_);
-            stats.allocated_blocks = chunk_block_count_ * chunks_.size() - free_blocks_;
-            stats.free_blocks = free_blocks_;
-            stats.total_chunks = chunks_.size();
-            stats.total_memory = chunks_.size() * block_size_ * chunk_block_count_;
+            std::lock_guard<std::mutex> lock(caches_mutex_);
+            AccumulateCounters(stats, shared_counters_);
+            for (const auto& cache : thread_caches_)
+            {
+                const size_t capacity = cache->capacity.load(std::memory_order_relaxed);
+                stats.thread_cache_blocks += cache->cached_blocks.load(std::memory_order_relaxed);
+                stats.thread_cache_capacity += capacity;
+                stats.thread_cache_capacities.push_back(capacity);
+                AccumulateCounters(stats, cache->counters);
+            }
         }
-
-        // 线程本地缓存统计（近似值）
-        stats.thread_cache_blocks = thread_cache_size_ * active_threads_.load();
+        stats.allocated_blocks -= std::min(stats.allocated_blocks, stats.thread_cache_blocks);
         stats.free_blocks += stats.thread_cache_blocks;
 
         return stats;
     }
 
+    // 对齐后的块大小
+    size_t GetBlockSize() const
+    {
+        return block_size_;
+    }
+
     // 禁用拷贝和赋值
     MemoryPool(const MemoryPool&) = delete;
     MemoryPool& operator=(const MemoryPool&) = delete;
@@ -193,40 +439,507 @@ private:
         Node* next;
     };
 
+    // 无锁模式下批次的首个内存块：next串起批次内的块，next_batch串起栈中的批次
+    struct BatchNode
+    {
+        Node* next;
+        std::atomic<BatchNode*> next_batch;
+    };
+
+    // 无锁栈栈顶为“指针+标签”：64位平台低48位存指针、高16位存标签，32位平台各占32位，
+    // 每次成功修改栈顶标签加一，避免ABA问题
+    static constexpr unsigned kTagShift = sizeof(void*) == 8 ? 48 : 32;
+    static constexpr uint64_t kPointerMask = (uint64_t(1) << kTagShift) - 1;
+
+    static uint64_t PackHead(BatchNode* batch, uint64_t tag)
+    {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(batch)) | (tag << kTagShift);
+    }
+
+    static BatchNode* HeadPointer(uint64_t head)
+    {
+        return reinterpret_cast<BatchNode*>(static_cast<uintptr_t>(head & kPointerMask));
+    }
+
+    static uint64_t HeadTag(uint64_t head)
+    {
+        return head >> kTagShift;
+    }
+
+    // 最小块大小：空闲块内需要放下链表节点（无锁模式为批次节点）
+    static size_t MinBlockSize(CentralListMode mode)
+    {
+        return mode == CentralListMode::LockFree ? sizeof(BatchNode) : sizeof(Node);
+    }
+
+    // 操作计数：线程缓存中的计数只由所属线程写入（relaxed读改写，无原子RMW开销），统计时随时读取
+    struct OperationCounters
+    {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> deallocations{0};
+        std::atomic<uint64_t> refills{0};
+        std::atomic<uint64_t> returns{0};
+    };
+
+    // 单写者计数器自增
+    static void Bump(std::atomic<uint64_t>& counter, uint64_t n = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static void AccumulateCounters(MemoryStats& stats, const OperationCounters& counters)
+    {
+        stats.allocations += counters.allocations.load(std::memory_order_relaxed);
+        stats.deallocations += counters.deallocations.load(std::memory_order_relaxed);
+        stats.refills += counters.refills.load(std::memory_order_relaxed);
+        stats.returns += counters.returns.load(std::memory_order_relaxed);
+    }
+
+    // 线程缓存：每个线程在每个内存池中各有一份，内存由内存池持有
+    struct ThreadCache
+    {
+        std::vector<void*> blocks;                  // 缓存的内存块（仅所属线程访问）
+        uint64_t seen_epoch = 0;                    // 已处理的回收纪元（仅所属线程访问）
+        std::atomic<uint64_t> acked_epoch{0};       // 已确认的回收纪元（收缩线程读取）
+        std::atomic<size_t> cached_blocks{0};       // 缓存块数（收缩线程读取）
+        std::atomic<size_t> capacity{0};            // 有效容量（仅所属线程修改，统计时读取）
+        std::chrono::steady_clock::time_point last_miss;  // 上次未命中的时间（仅所属线程访问）
+        OperationCounters counters;                 // 本线程的操作计数
+    };
+
+    // 线程本地缓存表：按池ID记录当前线程在各个内存池中的缓存
+    class ThreadCacheTable
+    {
+    public:
+        // 线程退出时把缓存归还给仍然存活的内存池
+        ~ThreadCacheTable()
+        {
+            destroyed_ = true;
+            for (const Entry& entry : entries_)
+            {
+                MemoryPool::ReleaseThreadCache(entry.pool_id, entry.cache);
+            }
+        }
+
+        // 查找指定内存池的缓存，最近一次命中的条目单独记录以加速连续访问
+        ThreadCache* Find(uint64_t pool_id)
+        {
+            if (last_.pool_id == pool_id)
+            {
+                return last_.cache;
+            }
+
+            for (const Entry& entry : entries_)
+            {
+                if (entry.pool_id == pool_id)
+                {
+                    last_ = entry;
+                    return entry.cache;
+                }
+            }
+
+            return nullptr;
+        }
+
+        // 添加缓存条目，顺便清理已销毁内存池留下的失效条目
+        void Add(uint64_t pool_id, ThreadCache* cache)
+        {
+            entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                          [](const Entry& entry) { return !MemoryPool::IsPoolAlive(entry.pool_id); }),
+                           entries_.end());
+            entries_.push_back(Entry{pool_id, cache});
+            last_ = entries_.back();
+        }
+
+        // 移除缓存条目（内存池在当前线程销毁时调用）
+        void Remove(uint64_t pool_id)
+        {
+            entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                          [pool_id](const Entry& entry) { return entry.pool_id == pool_id; }),
+                           entries_.end());
+            if (last_.pool_id == pool_id)
+            {
+                last_ = Entry{};
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            uint64_t pool_id = 0;
+            ThreadCache* cache = nullptr;
+        };
+
+        std::vector<Entry> entries_;  // 所有缓存条目
+        Entry last_;                  // 最近一次命中的条目
+
+    public:
+        inline static thread_local bool destroyed_ = false;  // 当前线程的缓存表是否已析构
+    };
+
     // 计算对齐后的块大小
     static size_t CalculateAlignedSize(size_t block_size, size_t alignment)
     {
         return (block_size + alignment - 1) & ~(alignment - 1);
     }
 
-    // 扩展中央内存池
+    // 扩展中央内存池（调用方需持有central_mutex_）
     void Expand()
     {
-        std::lock_guard<std::mutex> lock(central_mutex_);
-
         size_t chunk_size = block_size_ * chunk_block_count_;
-        char* chunk = static_cast<char*>(operator new(chunk_size));
+        char* chunk = static_cast<char*>(chunk_provider_->Allocate(chunk_size, alignment_));
+
+        if (central_mode_ == CentralListMode::LockFree && (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(chunk + chunk_size)) & ~kPointerMask) != 0)
+        {
+            // 地址超出标签指针可表示的范围（仅可能出现在启用5级页表的系统上）
+            chunk_provider_->Deallocate(chunk, chunk_size, alignment_);
+            throw std::bad_alloc();
+        }
+
         chunks_.push_back(chunk);
+        chunk_count_.store(chunks_.size(), std::memory_order_relaxed);
 
         POOL_LOG("Expanding: allocated new chunk of " << chunk_size / 1024 << " KB");
 
-        // 添加到空闲链表
-        for (size_t i = 0; i < chunk_block_count_; ++i)
+        if (central_mode_ == CentralListMode::LockFree)
+        {
+            // 按地址顺序切分成若干批次，所有批次串好后一次CAS挂到栈上
+            BatchNode* first_batch = nullptr;
+            BatchNode* last_batch = nullptr;
+            for (size_t begin = 0; begin < chunk_block_count_; begin += thread_cache_size_)
+            {
+                const size_t end = std::min(begin + thread_cache_size_, chunk_block_count_);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    Node* node = reinterpret_cast<Node*>(chunk + i * block_size_);
+                    node->next = (i + 1 < end) ? reinterpret_cast<Node*>(chunk + (i + 1) * block_size_) : nullptr;
+                }
+
+                BatchNode* batch = MakeBatch(reinterpret_cast<Node*>(chunk + begin * block_size_));
+                if (last_batch)
+                {
+                    last_batch->next_batch.store(batch, std::memory_order_relaxed);
+                }
+                else
+                {
+                    first_batch = batch;
+                }
+                last_batch = batch;
+            }
+
+            free_blocks_.fetch_add(chunk_block_count_, std::memory_order_relaxed);
+            PushBatches(first_batch, last_batch);
+            return;
+        }
+
+        // 添加到空闲链表（逆序压入，弹出时按地址递增，连续分配的块在内存中也连续）
+        for (size_t i = chunk_block_count_; i-- > 0; )
         {
             Node* node = reinterpret_cast<Node*>(chunk + i * block_size_);
             node->next = free_list_;
             free_list_ = node;
         }
 
-        free_blocks_ += chunk_block_count_;
+        free_blocks_.fetch_add(chunk_block_count_, std::memory_order_relaxed);
+    }
+
+    // 把以first为首的一串内存块初始化为一个批次
+    static BatchNode* MakeBatch(Node* first)
+    {
+        Node* next = first->next;
+        BatchNode* batch = new (static_cast<void*>(first)) BatchNode;
+        batch->next = next;
+        batch->next_batch.store(nullptr, std::memory_order_relaxed);
+        return batch;
+    }
+
+    // 把已经串好的若干批次（first...last）一次CAS压入无锁栈
+    void PushBatches(BatchNode* first, BatchNode* last)
+    {
+        uint64_t head = batch_head_.load(std::memory_order_relaxed);
+        do
+        {
+            last->next_batch.store(HeadPointer(head), std::memory_order_relaxed);
+        }
+        while (!batch_head_.compare_exchange_weak(head, PackHead(first, HeadTag(head) + 1), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // 无锁栈读者登记：收缩线程释放chunk前会等待所有可能读到旧栈顶的线程离开
+    class PopReaderGuard
+    {
+    public:
+        explicit PopReaderGuard(MemoryPool& pool)
+            : readers_(pool.pop_readers_[pool.pop_phase_.load() & 1])
+        {
+            readers_.fetch_add(1);
+        }
+
+        ~PopReaderGuard()
+        {
+            readers_.fetch_sub(1, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<size_t>& readers_;
+    };
+
+    // 从无锁栈弹出一个批次，栈空时加锁扩展后重试
+    // 返回批次内的块链表
+    Node* PopBatch()
+    {
+        while (true)
+        {
+            {
+                PopReaderGuard guard(*this);
+                uint64_t head = batch_head_.load();
+                while (BatchNode* batch = HeadPointer(head))
+                {
+                    // batch可能已被其他线程弹出并改写，此时标签已变化，下面的CAS必然失败
+                    BatchNode* next = batch->next_batch.load(std::memory_order_relaxed);
+                    if (batch_head_.compare_exchange_weak(head, PackHead(next, HeadTag(head) + 1)))
+                    {
+                        return reinterpret_cast<Node*>(batch);
+                    }
+                }
+            }
+
+            // 栈空时加锁扩展；加锁前必须先注销读者身份，否则会与等待读者离开的收缩线程死锁
+            auto lock = LockCentral();
+            if (!HeadPointer(batch_head_.load(std::memory_order_acquire)))
+            {
+                Expand();
+            }
+        }
+    }
+
+    // 把一组内存块链成一个批次压入无锁栈
+    void PushBlocks(void* const* blocks, size_t count)
+    {
+        if (count == 0) return;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            static_cast<Node*>(blocks[i])->next = (i + 1 < count) ? static_cast<Node*>(blocks[i + 1]) : nullptr;
+        }
+
+        BatchNode* batch = MakeBatch(static_cast<Node*>(blocks[0]));
+        free_blocks_.fetch_add(count, std::memory_order_relaxed);
+        PushBatches(batch, batch);
+    }
+
+    // 摘下整个中央空闲链表（调用方需持有central_mutex_）
+    // count: 输出摘下的块数
+    Node* DetachCentralFreeList(size_t& count)
+    {
+        Node* list = nullptr;
+        if (central_mode_ == CentralListMode::LockFree)
+        {
+            uint64_t head = batch_head_.load();
+            while (!batch_head_.compare_exchange_weak(head, PackHead(nullptr, HeadTag(head) + 1)))
+            {
+            }
+
+            // 切换读者阶段并等待旧阶段的读者离开，之后不会再有线程访问摘下的批次
+            const uint32_t old_phase = pop_phase_.fetch_add(1) & 1;
+            while (pop_readers_[old_phase].load(std::memory_order_acquire) != 0)
+            {
+                std::this_thread::yield();
+            }
+
+            // 批次串接成单链表
+            for (BatchNode* batch = HeadPointer(head); batch; )
+            {
+                BatchNode* next_batch = batch->next_batch.load(std::memory_order_relaxed);
+                Node* last = reinterpret_cast<Node*>(batch);
+                while (last->next)
+                {
+                    last = last->next;
+                }
+                last->next = list;
+                list = reinterpret_cast<Node*>(batch);
+                batch = next_batch;
+            }
+        }
+        else
+        {
+            list = free_list_;
+            free_list_ = nullptr;
+        }
+
+        count = 0;
+        for (Node* node = list; node; node = node->next)
+        {
+            ++count;
+        }
+
+        free_blocks_.fetch_sub(count, std::memory_order_relaxed);
+        return list;
+    }
+
+    // 把单链表放回中央空闲链表（调用方需持有central_mutex_）
+    void AttachCentralFreeList(Node* list, size_t count)
+    {
+        if (central_mode_ == CentralListMode::LockFree)
+        {
+            // 按批次重新发布到无锁栈
+            std::vector<void*> batch;
+            batch.reserve(thread_cache_size_);
+            while (list)
+            {
+                Node* node = list;
+                list = node->next;
+                batch.push_back(node);
+                if (batch.size() == thread_cache_size_)
+                {
+                    PushBlocks(batch.data(), batch.size());
+                    batch.clear();
+                }
+            }
+
+            PushBlocks(batch.data(), batch.size());
+            return;
+        }
+
+        while (list)
+        {
+            Node* node = list;
+            list = node->next;
+            node->next = free_list_;
+            free_list_ = node;
+        }
+
+        free_blocks_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    // 统计每个chunk的空闲块数，释放完全空闲的chunk，并从链表中剔除属于已释放chunk的块
+    // （调用方需持有central_mutex_）
+    // free_list/free_count: 输入为全部中央空闲块，输出为剩余的空闲块
+    // 返回释放的chunk数量
+    size_t ReleaseFreeChunks(Node*& free_list, size_t& free_count, size_t min_free_blocks)
+    {
+        if (free_count <= min_free_blocks || free_count < chunk_block_count_)
+        {
+            return 0;
+        }
+
+        // 按地址排序的chunk索引，用于二分查找块所在的chunk
+        const size_t chunk_bytes = block_size_ * chunk_block_count_;
+        std::vector<size_t> order(chunks_.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [this](size_t a, size_t b) { return chunks_[a] < chunks_[b]; });
+
+        auto find_chunk = [&](const Node* node) -> size_t
+        {
+            auto it = std::upper_bound(order.begin(), order.end(), node,
+                                       [this](const Node* n, size_t index) { return static_cast<const void*>(n) < chunks_[index]; });
+            if (it == order.begin())
+            {
+                return chunks_.size();
+            }
+
+            const size_t index = *(it - 1);
+            const char* base = static_cast<const char*>(chunks_[index]);
+            return reinterpret_cast<const char*>(node) < base + chunk_bytes ? index : chunks_.size();
+        };
+
+        // 统计每个chunk的空闲块数
+        std::vector<size_t> free_in_chunk(chunks_.size(), 0);
+        for (Node* node = free_list; node; node = node->next)
+        {
+            const size_t index = find_chunk(node);
+            if (index < chunks_.size())
+            {
+                ++free_in_chunk[index];
+            }
+        }
+
+        // 从最新的chunk开始释放完全空闲的chunk，直到剩余空闲块数达到下限
+        std::vector<bool> released(chunks_.size(), false);
+        size_t released_count = 0;
+        size_t remaining = free_count;
+        for (size_t i = chunks_.size(); i-- > 0; )
+        {
+            if (free_in_chunk[i] == chunk_block_count_ && remaining - chunk_block_count_ >= min_free_blocks)
+            {
+                released[i] = true;
+                remaining -= chunk_block_count_;
+                ++released_count;
+            }
+
+            if (remaining < min_free_blocks + chunk_block_count_)
+            {
+                break;
+            }
+        }
+
+        if (released_count == 0)
+        {
+            return 0;
+        }
+
+        // 从空闲链表中剔除属于已释放chunk的块
+        Node* kept = nullptr;
+        while (free_list)
+        {
+            Node* node = free_list;
+            free_list = node->next;
+            const size_t index = find_chunk(node);
+            if (index < chunks_.size() && released[index])
+            {
+                continue;
+            }
+            node->next = kept;
+            kept = node;
+        }
+        free_list = kept;
+        free_count = remaining;
+
+        // 释放chunk
+        std::vector<void*> kept_chunks;
+        kept_chunks.reserve(chunks_.size() - released_count);
+        for (size_t i = 0; i < chunks_.size(); ++i)
+        {
+            if (released[i])
+            {
+                chunk_provider_->Deallocate(chunks_[i], chunk_bytes, alignment_);
+            }
+            else
+            {
+                kept_chunks.push_back(chunks_[i]);
+            }
+        }
+        chunks_.swap(kept_chunks);
+        chunk_count_.store(chunks_.size(), std::memory_order_relaxed);
+
+        return released_count;
     }
 
     // 填充线程本地缓存
-    void RefillLocalCache()
+    // capacity: 缓存当前的有效容量
+    void RefillLocalCache(std::vector<void*>& local_cache, size_t capacity)
     {
-        TrackThreadActivity();
+        // 无锁模式：每次CAS取走整批，容量大于一批时连续取多批
+        if (central_mode_ == CentralListMode::LockFree)
+        {
+            size_t fetch_count = 0;
+            do
+            {
+                for (Node* node = PopBatch(); node; node = node->next)
+                {
+                    local_cache.push_back(node);
+                    ++fetch_count;
+                }
+            }
+            while (local_cache.size() + thread_cache_size_ <= capacity);
 
-        std::lock_guard<std::mutex> lock(central_mutex_);
+            free_blocks_.fetch_sub(fetch_count, std::memory_order_relaxed);
+            return;
+        }
+
+        auto lock = LockCentral();
 
         // 中央池无空闲内存时扩展
         if (free_list_ == nullptr)
@@ -235,170 +948,511 @@ private:
         }
 
         // 批量填充本地缓存
-        size_t fetch_count = std::min(thread_cache_size_, free_blocks_);
+        size_t fetch_count = std::min(capacity, free_blocks_.load(std::memory_order_relaxed));
         for (size_t i = 0; i < fetch_count; ++i)
         {
             Node* node = free_list_;
             free_list_ = free_list_->next;
-            local_cache_.push_back(node);
-            --free_blocks_;
+            local_cache.push_back(node);
+        }
+
+        free_blocks_.fetch_sub(fetch_count, std::memory_order_relaxed);
+    }
+
+    // 获取中央池锁，发生竞争时记录等待次数和耗时（无竞争时只多一次try_lock）
+    std::unique_lock<std::mutex> LockCentral()
+    {
+        std::unique_lock<std::mutex> lock(central_mutex_, std::try_to_lock);
+        if (!lock.owns_lock())
+        {
+            const auto begin = std::chrono::steady_clock::now();
+            lock.lock();
+            const auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+            lock_waits_.fetch_add(1, std::memory_order_relaxed);
+            lock_wait_ns_.fetch_add(static_cast<uint64_t>(waited.count()), std::memory_order_relaxed);
         }
+        return lock;
+    }
+
+    // 采样峰值占用：中央池之外的块数（已分配+线程缓存），在块离开中央池后调用
+    void UpdatePeakInUse()
+    {
+        const size_t total_blocks = chunk_count_.load(std::memory_order_relaxed) * chunk_block_count_;
+        const size_t free_blocks = free_blocks_.load(std::memory_order_relaxed);
+        const size_t in_use = total_blocks > free_blocks ? total_blocks - free_blocks : 0;
+
+        size_t peak = peak_in_use_.load(std::memory_order_relaxed);
+        while (in_use > peak && !peak_in_use_.compare_exchange_weak(peak, in_use, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    // 根据未命中（缓存为空需要补充、或已满需要归还）的频率调整缓存容量
+    // 两次未命中的间隔短于空闲阈值时扩容一批，超过阈值时容量减半；扩容受全局上限约束
+    void AdaptCapacity(ThreadCache& cache)
+    {
+        if (min_cache_capacity_ == max_cache_capacity_)
+        {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const bool idle = now - cache.last_miss >= cache_idle_interval_;
+        cache.last_miss = now;
+
+        const size_t capacity = cache.capacity.load(std::memory_order_relaxed);
+        size_t target = idle ? std::max(min_cache_capacity_, capacity / 2) : std::min(max_cache_capacity_, capacity + thread_cache_size_);
+        if (target > capacity)
+        {
+            target = capacity + ReserveCacheCapacity(target - capacity);
+        }
+        else
+        {
+            total_cache_capacity_.fetch_sub(capacity - target, std::memory_order_relaxed);
+        }
+
+        if (target != capacity)
+        {
+            cache.capacity.store(target, std::memory_order_relaxed);
+            POOL_LOG("Thread " << std::this_thread::get_id() << " cache capacity " << capacity << " -> " << target);
+        }
+    }
+
+    // 从全局缓存额度中申请容量，返回实际得到的容量（可能小于wanted）
+    size_t ReserveCacheCapacity(size_t wanted)
+    {
+        if (global_cache_limit_ == 0)
+        {
+            total_cache_capacity_.fetch_add(wanted, std::memory_order_relaxed);
+            return wanted;
+        }
+
+        size_t total = total_cache_capacity_.load(std::memory_order_relaxed);
+        size_t granted = 0;
+        do
+        {
+            granted = total >= global_cache_limit_ ? 0 : std::min(wanted, global_cache_limit_ - total);
+            if (granted == 0)
+            {
+                return 0;
+            }
+        }
+        while (!total_cache_capacity_.compare_exchange_weak(total, total + granted, std::memory_order_relaxed));
+
+        return granted;
     }
 
     // 归还本地缓存到中央池
-    void ReturnLocalCache()
+    void ReturnLocalCache(std::vector<void*>& local_cache)
     {
-        if (local_cache_.empty()) return;
+        if (local_cache.empty()) return;
 
-        std::lock_guard<std::mutex> lock(central_mutex_);
+        ReturnToCentral(local_cache.data(), local_cache.size());
+
+        POOL_LOG("Thread " << std::this_thread::get_id() << " returned " << local_cache.size() << " blocks");
+
+        local_cache.clear();
+    }
+
+    // 把一组内存块整段归还中央池，保持原有顺序
+    void ReturnToCentral(void* const* blocks, size_t count)
+    {
+        if (count == 0) return;
+
+        // 无锁模式：按缓存大小切成若干批次，串好后一次CAS归还
+        if (central_mode_ == CentralListMode::LockFree)
+        {
+            BatchNode* first_batch = nullptr;
+            BatchNode* last_batch = nullptr;
+            for (size_t begin = 0; begin < count; begin += thread_cache_size_)
+            {
+                const size_t end = std::min(begin + thread_cache_size_, count);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    static_cast<Node*>(blocks[i])->next = (i + 1 < end) ? static_cast<Node*>(blocks[i + 1]) : nullptr;
+                }
+
+                BatchNode* batch = MakeBatch(static_cast<Node*>(blocks[begin]));
+                if (last_batch)
+                {
+                    last_batch->next_batch.store(batch, std::memory_order_relaxed);
+                }
+                else
+                {
+                    first_batch = batch;
+                }
+                last_batch = batch;
+            }
+
+            free_blocks_.fetch_add(count, std::memory_order_relaxed);
+            PushBatches(first_batch, last_batch);
+            return;
+        }
 
-        for (void* ptr : local_cache_)
+        auto lock = LockCentral();
+
+        for (size_t i = count; i-- > 0; )
         {
-            Node* node = static_cast<Node*>(ptr);
+            Node* node = static_cast<Node*>(blocks[i]);
             node->next = free_list_;
             free_list_ = node;
-            ++free_blocks_;
         }
 
-        POOL_LOG("Thread " << std::this_thread::get_id() << " returned " << local_cache_.size() << " blocks");
-
-        local_cache_.clear();
+        free_blocks_.fetch_add(count, std::memory_order_relaxed);
     }
 
-    // 重建空闲链表
-    void RebuildFreeList()
+    // 从中央池整段取走count个块
+    // surplus: 无锁模式下整批取出后多余的块优先放入该缓存（不超过surplus_limit），其余放回中央池
+    void TakeFromCentral(void** blocks, size_t count, std::vector<void*>* surplus, size_t surplus_limit)
     {
-        free_list_ = nullptr;
-        free_blocks_ = 0;
+        if (central_mode_ == CentralListMode::LockFree)
+        {
+            size_t filled = 0;
+            while (filled < count)
+            {
+                Node* node = nullptr;
+                try
+                {
+                    node = PopBatch();
+                }
+                catch (...)
+                {
+                    ReturnToCentral(blocks, filled);
+                    throw;
+                }
 
-        for (void* chunk : chunks_)
+                size_t taken = 0;
+                while (node && filled < count)
+                {
+                    blocks[filled++] = node;
+                    node = node->next;
+                    ++taken;
+                }
+
+                // 最后一批的剩余部分
+                while (node && surplus && surplus->size() < surplus_limit)
+                {
+                    surplus->push_back(node);
+                    node = node->next;
+                    ++taken;
+                }
+                free_blocks_.fetch_sub(taken, std::memory_order_relaxed);
+
+                if (node)
+                {
+                    BatchNode* batch = MakeBatch(node);
+                    PushBatches(batch, batch);
+                }
+            }
+            return;
+        }
+
+        auto lock = LockCentral();
+
+        size_t filled = 0;
+        try
         {
-            for (size_t i = 0; i < chunk_block_count_; ++i)
+            for (; filled < count; ++filled)
             {
-                Node* node = reinterpret_cast<Node*>(static_cast<char*>(chunk) + i * block_size_);
+                // 中央池不足时直接扩展，新chunk的块按地址顺序整段交给调用方
+                if (free_list_ == nullptr)
+                {
+                    Expand();
+                }
+
+                blocks[filled] = free_list_;
+                free_list_ = free_list_->next;
+            }
+        }
+        catch (...)
+        {
+            // 扩展失败，已取出的块放回原处
+            while (filled > 0)
+            {
+                Node* node = static_cast<Node*>(blocks[--filled]);
                 node->next = free_list_;
                 free_list_ = node;
-                ++free_blocks_;
             }
+            throw;
         }
+
+        free_blocks_.fetch_sub(count, std::memory_order_relaxed);
     }
 
-    // 收集所有空闲块到中央池
-    void CollectFreeBlocks()
+    // 发布新的回收纪元，通知所有线程归还本地缓存，等待确认或超时
+    void RequestOtherThreadsReturn(std::chrono::milliseconds timeout)
     {
-        // 1. 收集中央池现有的空闲块
-        RebuildFreeList();
+        POOL_LOG("Requesting other threads to return cache blocks");
+
+        const uint64_t epoch = reclaim_epoch_.fetch_add(1) + 1;
 
-        // 2. 收集当前线程的本地缓存
-        if (!local_cache_.empty())
+        // 当前线程直接归还
+        ThreadCacheTable* table = LocalTable();
+        if (ThreadCache* cache = table ? table->Find(id_) : nullptr)
         {
-            std::lock_guard<std::mutex> lock(central_mutex_);
-            for (void* ptr : local_cache_)
+            AcknowledgeReclaim(*cache);
+        }
+
+        std::unique_lock<std::mutex> lock(reclaim_mutex_);
+        reclaim_cv_.wait_for(lock, timeout, [this, epoch] { return AllCachesAcknowledged(epoch); });
+    }
+
+    // 所有线程缓存都已确认指定纪元（或缓存为空）
+    bool AllCachesAcknowledged(uint64_t epoch)
+    {
+        std::lock_guard<std::mutex> lock(caches_mutex_);
+        for (const auto& cache : thread_caches_)
+        {
+            if (cache->acked_epoch.load(std::memory_order_acquire) < epoch && cache->cached_blocks.load(std::memory_order_relaxed) != 0)
             {
-                Node* node = static_cast<Node*>(ptr);
-                node->next = free_list_;
-                free_list_ = node;
-                ++free_blocks_;
+                return false;
             }
-            POOL_LOG("Thread " << std::this_thread::get_id() << " returned " << local_cache_.size() << " blocks");
-            local_cache_.clear();
         }
+        return true;
+    }
+
+    // 所属线程响应回收请求：归还整个缓存并确认纪元
+    void AcknowledgeReclaim(ThreadCache& cache)
+    {
+        const uint64_t epoch = reclaim_epoch_.load(std::memory_order_acquire);
+        ReturnLocalCache(cache.blocks);
+        cache.cached_blocks.store(0, std::memory_order_relaxed);
+        cache.seen_epoch = epoch;
+        cache.acked_epoch.store(epoch, std::memory_order_release);
+
+        POOL_LOG("Thread " << std::this_thread::get_id() << " acknowledged reclaim epoch " << epoch);
 
-        // 3. 请求其他线程归还本地缓存
-        RequestOtherThreadsReturn();
+        std::lock_guard<std::mutex> lock(reclaim_mutex_);
+        reclaim_cv_.notify_all();
     }
 
-    // 请求其他线程归还本地缓存
-    void RequestOtherThreadsReturn()
+    // 获取当前线程在本池中的缓存，首次访问时创建并登记
+    // 线程的缓存表已析构（线程局部变量析构之后的静态析构阶段）时返回nullptr
+    ThreadCache* LocalCache()
     {
-        POOL_LOG("Requesting other threads to return cache blocks");
+        ThreadCacheTable* table = LocalTable();
+        if (!table)
+        {
+            return nullptr;
+        }
+
+        if (ThreadCache* cache = table->Find(id_))
+        {
+            return cache;
+        }
+
+        return &RegisterThreadCache(*table);
+    }
+
+    // 绕过线程缓存直接从中央池分配
+    void* AllocateFromCentral()
+    {
+        if (central_mode_ == CentralListMode::LockFree)
+        {
+            // 取一整批，只留第一个块，其余作为新批次放回
+            Node* node = PopBatch();
+            free_blocks_.fetch_sub(1, std::memory_order_relaxed);
+            if (Node* rest = node->next)
+            {
+                BatchNode* batch = MakeBatch(rest);
+                PushBatches(batch, batch);
+            }
+            return node;
+        }
 
-        // 标记全局需要回收内存
-        memory_reclaim_requested_.store(true, std::memory_order_release);
+        auto lock = LockCentral();
 
-        // 给其他线程时间响应请求
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (free_list_ == nullptr)
+        {
+            Expand();
+        }
+
+        Node* node = free_list_;
+        free_list_ = free_list_->next;
+        free_blocks_.fetch_sub(1, std::memory_order_relaxed);
+        return node;
+    }
+
+    // 绕过线程缓存直接归还到中央池
+    void DeallocateToCentral(void* ptr)
+    {
+        if (central_mode_ == CentralListMode::LockFree)
+        {
+            PushBlocks(&ptr, 1);
+            return;
+        }
 
-        // 重置请求标志
-        memory_reclaim_requested_.store(false, std::memory_order_release);
+        auto lock = LockCentral();
+        Node* node = static_cast<Node*>(ptr);
+        node->next = free_list_;
+        free_list_ = node;
+        free_blocks_.fetch_add(1, std::memory_order_relaxed);
     }
 
-    // 跟踪线程活动
-    void TrackThreadActivity()
+    // 为当前线程创建缓存，缓存由内存池持有，线程只在缓存表中记录指针
+    ThreadCache& RegisterThreadCache(ThreadCacheTable& table)
     {
-        static thread_local bool is_tracked = false;
-        if (!is_tracked)
+        auto cache = std::make_unique<ThreadCache>();
+        cache->blocks.reserve(thread_cache_size_);
+        cache->seen_epoch = reclaim_epoch_.load(std::memory_order_acquire);
+
+        // 初始容量：下限部分总是保证，超出下限的部分受全局上限约束
+        const size_t initial = std::clamp(thread_cache_size_, min_cache_capacity_, max_cache_capacity_);
+        total_cache_capacity_.fetch_add(min_cache_capacity_, std::memory_order_relaxed);
+        cache->capacity.store(min_cache_capacity_ + ReserveCacheCapacity(initial - min_cache_capacity_), std::memory_order_relaxed);
+        cache->last_miss = std::chrono::steady_clock::now();
+        ThreadCache* raw = cache.get();
+
         {
-            active_threads_.fetch_add(1, std::memory_order_relaxed);
-            is_tracked = true;
+            std::lock_guard<std::mutex> lock(caches_mutex_);
+            thread_caches_.push_back(std::move(cache));
+        }
 
-            // 注册线程退出回调
-            static thread_local struct ThreadExitNotifier
+        active_threads_.fetch_add(1, std::memory_order_relaxed);
+        table.Add(id_, raw);
+
+        POOL_LOG("Thread " << std::this_thread::get_id() << " registered thread cache");
+        return *raw;
+    }
+
+    // 线程退出时归还并销毁该线程在本池中的缓存
+    void RetireThreadCache(ThreadCache* cache)
+    {
+        ReturnLocalCache(cache->blocks);
+        total_cache_capacity_.fetch_sub(cache->capacity.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock(caches_mutex_);
+            for (auto it = thread_caches_.begin(); it != thread_caches_.end(); ++it)
             {
-                ~ThreadExitNotifier()
+                if (it->get() == cache)
                 {
-                    if (pool_)
-                    {
-                        // 归还当前线程缓存
-                        pool_->ReturnCurrentThreadCache();
-                        pool_->active_threads_.fetch_sub(1, std::memory_order_relaxed);
-                    }
+                    // 计数并入共享计数，统计结果不因线程退出而回退
+                    shared_counters_.allocations.fetch_add(cache->counters.allocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    shared_counters_.deallocations.fetch_add(cache->counters.deallocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    shared_counters_.refills.fetch_add(cache->counters.refills.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    shared_counters_.returns.fetch_add(cache->counters.returns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    thread_caches_.erase(it);
+                    break;
                 }
-                MemoryPool* pool_ = nullptr;
-            } notifier;
-
-            notifier.pool_ = this;
+            }
         }
+
+        active_threads_.fetch_sub(1, std::memory_order_relaxed);
+        POOL_LOG("Thread " << std::this_thread::get_id() << " exited and retired its thread cache");
+
+        // 正在收缩的线程无需再等待该缓存
+        std::lock_guard<std::mutex> lock(reclaim_mutex_);
+        reclaim_cv_.notify_all();
     }
 
-    // 归还当前线程缓存
-    void ReturnCurrentThreadCache()
+    // 存活内存池登记表（池ID单调递增且不复用，已销毁池的ID不会再被匹配）
+    struct PoolRegistry
     {
-        if (local_cache_.empty()) return;
+        std::mutex mutex;
+        std::unordered_map<uint64_t, MemoryPool*> pools;
+        uint64_t next_id = 1;
+    };
 
-        std::lock_guard<std::mutex> lock(central_mutex_);
+    // 登记表永不析构，保证静态对象析构后退出的线程仍可安全查询
+    static PoolRegistry& Registry()
+    {
+        static PoolRegistry* registry = new PoolRegistry();
+        return *registry;
+    }
 
-        for (void* ptr : local_cache_)
+    static uint64_t RegisterPool(MemoryPool* pool)
+    {
+        PoolRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        uint64_t id = registry.next_id++;
+        registry.pools.emplace(id, pool);
+        return id;
+    }
+
+    static void UnregisterPool(uint64_t id)
+    {
+        PoolRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.pools.erase(id);
+    }
+
+    // 线程退出时调用：池仍存活则归还缓存，持有登记表锁保证期间池不会被销毁
+    static void ReleaseThreadCache(uint64_t id, ThreadCache* cache)
+    {
+        PoolRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.pools.find(id);
+        if (it != registry.pools.end())
         {
-            Node* node = static_cast<Node*>(ptr);
-            node->next = free_list_;
-            free_list_ = node;
-            ++free_blocks_;
+            it->second->RetireThreadCache(cache);
         }
+    }
 
-        POOL_LOG("Thread " << std::this_thread::get_id() << " exited and returned " << local_cache_.size() << " blocks");
+    // 判断内存池是否仍然存活
+    static bool IsPoolAlive(uint64_t id)
+    {
+        PoolRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        return registry.pools.count(id) != 0;
+    }
+
+    // 当前线程的缓存表，线程局部变量析构后返回nullptr
+    static ThreadCacheTable* LocalTable()
+    {
+        if (ThreadCacheTable::destroyed_)
+        {
+            return nullptr;
+        }
 
-        local_cache_.clear();
+        static thread_local ThreadCacheTable table;
+        return &table;
     }
 
     // 中央池成员
+    const uint64_t id_;          // 内存池唯一标识（不复用）
+    CentralListMode central_mode_;  // 中央空闲链表实现方式
     size_t alignment_;           // 内存对齐要求
     size_t block_size_;          // 对齐后的块大小
     size_t chunk_block_count_;   // 每块内存包含的块数
-    size_t thread_cache_size_;   // 线程本地缓存大小
-
-    Node* free_list_ = nullptr;  // 中央空闲链表
-    size_t free_blocks_ = 0;     // 中央空闲块计数
+    size_t thread_cache_size_;   // 线程本地缓存初始大小（无锁模式下也是每批的块数）
+    ChunkProvider* chunk_provider_;  // chunk内存来源
+    size_t min_cache_capacity_;  // 线程缓存容量下限
+    size_t max_cache_capacity_;  // 线程缓存容量上限
+    size_t global_cache_limit_;  // 所有线程缓存容量之和的上限（0表示不限制）
+    std::chrono::milliseconds cache_idle_interval_;  // 空闲判定阈值
+    std::atomic<size_t> total_cache_capacity_{0};    // 所有线程缓存容量之和
+
+    Node* free_list_ = nullptr;  // 中央空闲链表（互斥锁模式）
+    std::atomic<size_t> free_blocks_{0};  // 中央空闲块计数
+    std::atomic<uint64_t> batch_head_{0}; // 无锁批次栈栈顶（无锁模式，指针+标签）
     std::vector<void*> chunks_;  // 分配的内存块
     mutable std::mutex central_mutex_; // 中央池互斥锁
 
-    // 线程本地缓存
-    thread_local static std::vector<void*> local_cache_;
+    // 各线程在本池中的缓存
+    std::vector<std::unique_ptr<ThreadCache>> thread_caches_;
+    mutable std::mutex caches_mutex_;    // 保护thread_caches_
 
     // 活动线程计数
     std::atomic<size_t> active_threads_{0};
 
-    // 内存回收请求标志
-    std::atomic<bool> memory_reclaim_requested_{false};
+    // 回收纪元：收缩时递增，各线程在下次分配/回收时归还缓存并确认
+    std::atomic<uint64_t> reclaim_epoch_{0};
+    std::mutex reclaim_mutex_;
+    std::condition_variable reclaim_cv_;
 
-#ifdef MEMORY_POOL_DEBUG
-    mutable std::atomic<size_t> alloc_count_{0};
-    static std::mutex log_mutex_;
-#endif
-};
+    // 无锁模式下正在读取栈顶批次的线程数，分两个阶段交替登记，收缩时等待旧阶段归零
+    std::atomic<uint32_t> pop_phase_{0};
+    std::atomic<size_t> pop_readers_[2]{};
+
+    // 统计
+    std::atomic<size_t> chunk_count_{0};        // chunk数量（统计时无需加中央池锁）
+    std::atomic<size_t> peak_in_use_{0};        // 峰值占用块数
+    std::atomic<uint64_t> lock_waits_{0};       // 中央池锁竞争次数
+    std::atomic<uint64_t> lock_wait_ns_{0};     // 中央池锁竞争累计等待时间
+    OperationCounters shared_counters_;         // 无线程缓存时的操作计数及已退出线程的累计计数
 
-// 静态成员初始化
-thread_local std::vector<void*> MemoryPool::local_cache_;
 #ifdef MEMORY_POOL_DEBUG
-std::mutex MemoryPool::log_mutex_;
+    inline static std::mutex log_mutex_;
 #endif
+};
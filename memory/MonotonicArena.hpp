@@ -0,0 +1,235 @@
+#pragma once
+
+#include "MemoryPool.hpp"
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+// 单调递增（bump-pointer）内存区
+// 从MemoryPool按块取内存，分配只移动指针，单个对象不回收，Rewind/Reset/Release时整体归还；
+// 适合生命周期相同的大量临时对象，例如一次请求处理中的字符串和容器
+// 超过块大小的请求转交上游内存资源，同样在Rewind/Release时统一释放
+// 非线程安全，一个内存区只能由一个线程使用
+class MonotonicArena : public std::pmr::memory_resource
+{
+public:
+    // 内存区位置标记，用于回退
+    struct Marker
+    {
+        void* chunk = nullptr;      // 标记时的当前块
+        char* ptr = nullptr;        // 标记时的分配位置
+        void* large = nullptr;      // 标记时最新的大块分配
+    };
+
+    // 作用域标记：构造时记录位置，析构时回退，作用域内的分配全部失效
+    class Scope
+    {
+    public:
+        explicit Scope(MonotonicArena& arena) : arena_(arena), marker_(arena.Mark()) {}
+        ~Scope() { arena_.Rewind(marker_); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        MonotonicArena& arena_;
+        Marker marker_;
+    };
+
+    // 构造函数
+    // pool: 提供内存块的内存池，块大小即每次扩展的字节数（需长于内存区存活）
+    // upstream: 超过块大小的请求使用的上游内存资源
+    explicit MonotonicArena(MemoryPool& pool = DefaultPool(), std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : pool_(pool), upstream_(upstream)
+    {
+    }
+
+    // 析构函数，归还所有内存
+    ~MonotonicArena() override
+    {
+        Release();
+    }
+
+    // 全局默认内存池：64KB块，永不析构
+    static MemoryPool& DefaultPool()
+    {
+        static MemoryPool* pool = new MemoryPool(64 * 1024, alignof(std::max_align_t), 8, 16);
+        return *pool;
+    }
+
+    // 分配内存
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+    {
+        char* aligned = AlignUp(ptr_, alignment);
+        if (chunk_ && aligned <= end_ && size <= static_cast<size_t>(end_ - aligned))
+        {
+            ptr_ = aligned + size;
+            bytes_used_ += size;
+            return aligned;
+        }
+
+        return AllocateSlow(size, alignment);
+    }
+
+    // 记录当前位置
+    Marker Mark() const
+    {
+        return Marker{chunk_, ptr_, large_};
+    }
+
+    // 回退到标记位置，之后分配的内存全部归还（标记必须来自本内存区且未被更早的回退作废）
+    void Rewind(const Marker& marker)
+    {
+        while (large_ != marker.large)
+        {
+            LargeHeader* large = large_;
+            large_ = large->prev;
+            upstream_->deallocate(large, large->total_size, large->alignment);
+            --large_count_;
+        }
+
+        while (chunk_ != marker.chunk)
+        {
+            ChunkHeader* chunk = chunk_;
+            chunk_ = chunk->prev;
+            pool_.Deallocate(chunk);
+            --chunk_count_;
+        }
+
+        ptr_ = marker.ptr;
+        end_ = chunk_ ? reinterpret_cast<char*>(chunk_) + pool_.GetBlockSize() : nullptr;
+    }
+
+    // 清空内容但保留最早的一个块，适合循环复用（如每个请求开始时调用）
+    void Reset()
+    {
+        ChunkHeader* first = chunk_;
+        while (first && first->prev)
+        {
+            first = first->prev;
+        }
+
+        Rewind(Marker{first, first ? ChunkBegin(first) : nullptr, nullptr});
+        bytes_used_ = 0;
+    }
+
+    // 归还所有内存
+    void Release()
+    {
+        Rewind(Marker{});
+        bytes_used_ = 0;
+    }
+
+    // 自上次Reset/Release以来分配的字节数（不含对齐填充）
+    size_t GetBytesUsed() const
+    {
+        return bytes_used_;
+    }
+
+    // 当前持有的块数
+    size_t GetChunkCount() const
+    {
+        return chunk_count_;
+    }
+
+    // 当前持有的大块分配数
+    size_t GetLargeCount() const
+    {
+        return large_count_;
+    }
+
+    // 禁用拷贝和赋值
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        return Allocate(bytes, alignment);
+    }
+
+    // 单个对象不回收，随Rewind/Reset/Release统一归还
+    void do_deallocate(void*, size_t, size_t) override
+    {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    // 块头：串成链表，最新的块在表头
+    struct ChunkHeader
+    {
+        ChunkHeader* prev;
+    };
+
+    // 大块分配头
+    struct LargeHeader
+    {
+        LargeHeader* prev;
+        size_t total_size;
+        size_t alignment;
+    };
+
+    static char* AlignUp(char* ptr, size_t alignment)
+    {
+        const uintptr_t value = reinterpret_cast<uintptr_t>(ptr);
+        return reinterpret_cast<char*>((value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1));
+    }
+
+    static char* ChunkBegin(ChunkHeader* chunk)
+    {
+        return reinterpret_cast<char*>(chunk) + sizeof(ChunkHeader);
+    }
+
+    // 当前块放不下：块内装得下就换新块，否则走上游
+    void* AllocateSlow(size_t size, size_t alignment)
+    {
+        const size_t usable = pool_.GetBlockSize() - sizeof(ChunkHeader);
+        if (alignment <= usable && size <= usable - alignment)    // 不用加法，避免size接近SIZE_MAX时回绕
+        {
+            ChunkHeader* chunk = static_cast<ChunkHeader*>(pool_.Allocate());
+            chunk->prev = chunk_;
+            chunk_ = chunk;
+            ++chunk_count_;
+            ptr_ = ChunkBegin(chunk);
+            end_ = reinterpret_cast<char*>(chunk) + pool_.GetBlockSize();
+
+            char* aligned = AlignUp(ptr_, alignment);
+            ptr_ = aligned + size;
+            bytes_used_ += size;
+            return aligned;
+        }
+
+        // 大块：头部放在对齐后的数据之前
+        const size_t header_size = (sizeof(LargeHeader) + alignment - 1) & ~(alignment - 1);
+        const size_t total_alignment = std::max(alignment, alignof(LargeHeader));
+        if (size > SIZE_MAX - header_size)
+        {
+            throw std::bad_alloc();     // 与std::pmr::monotonic_buffer_resource一致
+        }
+        const size_t total_size = header_size + size;
+        char* raw = static_cast<char*>(upstream_->allocate(total_size, total_alignment));
+
+        LargeHeader* large = reinterpret_cast<LargeHeader*>(raw);
+        large->prev = large_;
+        large->total_size = total_size;
+        large->alignment = total_alignment;
+        large_ = large;
+        ++large_count_;
+        bytes_used_ += size;
+        return raw + header_size;
+    }
+
+    MemoryPool& pool_;                          // 块来源
+    std::pmr::memory_resource* upstream_;       // 大块来源
+    ChunkHeader* chunk_ = nullptr;              // 当前块（链表头）
+    char* ptr_ = nullptr;                       // 当前块内的分配位置
+    char* end_ = nullptr;                       // 当前块末尾
+    LargeHeader* large_ = nullptr;              // 大块分配链表头
+    size_t chunk_count_ = 0;                    // 持有的块数
+    size_t large_count_ = 0;                    // 持有的大块分配数
+    size_t bytes_used_ = 0;                     // 已分配字节数
+};
@@ -16,6 +16,14 @@ public:
         static_assert(!std::is_array_v<T>, "ObjectPool does not support array types");
     }
 
+    // 构造函数
+    // config: 内存池配置（对齐要求至少为alignof(T)）
+    explicit ObjectPool(const MemoryPoolConfig& config)
+        : pool_(sizeof(T), WithAlignment(config))
+    {
+        static_assert(!std::is_array_v<T>, "ObjectPool does not support array types");
+    }
+
     // 构造一个对象
     // args: 传递给对象构造函数的参数
     template <typename... Args>
@@ -43,10 +51,71 @@ public:
         }
     }
 
-    // 释放多余的空闲内存
-    void ShrinkToFit(size_t min_free_blocks = 64)
+    // 批量构造对象
+    // count: 对象数量
+    // objects: 输出数组，至少容纳count个指针
+    // args: 传递给每个对象构造函数的参数（每个对象使用同一组参数）
+    // 任一对象构造失败时，已构造的对象全部销毁、内存全部归还，然后重新抛出异常
+    template <typename... Args>
+    void ConstructN(size_t count, T** objects, const Args&... args)
     {
-        pool_.ShrinkToFit(min_free_blocks);
+        void* blocks[kBatchStep];
+        size_t constructed = 0;
+        try
+        {
+            while (constructed < count)
+            {
+                const size_t n = std::min(kBatchStep, count - constructed);
+                pool_.AllocateBatch(n, blocks);
+
+                size_t i = 0;
+                try
+                {
+                    for (; i < n; ++i)
+                    {
+                        objects[constructed + i] = new (blocks[i]) T(args...);
+                    }
+                }
+                catch (...)
+                {
+                    pool_.DeallocateBatch(blocks + i, n - i);
+                    constructed += i;
+                    throw;
+                }
+
+                constructed += n;
+            }
+        }
+        catch (...)
+        {
+            DestroyN(objects, constructed);
+            throw;
+        }
+    }
+
+    // 批量销毁对象
+    void DestroyN(T* const* objects, size_t count)
+    {
+        void* blocks[kBatchStep];
+        for (size_t done = 0; done < count; )
+        {
+            size_t n = 0;
+            for (; n < kBatchStep && done < count; ++done)
+            {
+                if (T* obj = objects[done])
+                {
+                    obj->~T();
+                    blocks[n++] = obj;
+                }
+            }
+            pool_.DeallocateBatch(blocks, n);
+        }
+    }
+
+    // 释放完全空闲的内存块，返回释放的chunk数量
+    size_t ShrinkToFit(size_t min_free_blocks = 64, std::chrono::milliseconds handshake_timeout = std::chrono::milliseconds(10))
+    {
+        return pool_.ShrinkToFit(min_free_blocks, handshake_timeout);
     }
 
     // 获取内存统计信息
@@ -56,5 +125,13 @@ public:
     }
 
 private:
+    static constexpr size_t kBatchStep = 256;  // 批量构造/销毁时每次与内存池交换的块数
+
+    static MemoryPoolConfig WithAlignment(MemoryPoolConfig config)
+    {
+        config.alignment = std::max(config.alignment, std::alignment_of_v<T>);
+        return config;
+    }
+
     MemoryPool pool_;  // 底层内存池
 };
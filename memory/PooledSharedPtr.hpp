@@ -1,9 +1,11 @@
 #pragma once
 
-#include "ObjectPool.hpp"
+#include "MemoryPool.hpp"
 #include <memory>
 
 // 支持池化的共享指针模板类
+// 通过std::allocate_shared把控制块（引用计数）和对象放进同一个池块，每次创建只分配一次，
+// 返回标准的std::shared_ptr，weak_ptr、enable_shared_from_this等均可照常使用
 template <typename T>
 class PooledSharedPtr
 {
@@ -13,26 +15,89 @@ public:
     template <typename... Args>
     static std::shared_ptr<T> Create(Args&&... args)
     {
-        T* obj = pool_.Construct(std::forward<Args>(args)...);
-        return std::shared_ptr<T>(obj, [](T* p) { pool_.Destroy(p); });
+        return std::allocate_shared<T>(BlockAllocator<T>(), std::forward<Args>(args)...);
     }
 
-    // 获取内存统计信息
+    // 获取内存统计信息（尚未创建过对象时返回空统计）
     static MemoryStats GetStats()
     {
-        return pool_.GetStats();
+        MemoryPool* pool = pool_.load(std::memory_order_acquire);
+        return pool ? pool->GetStats() : MemoryStats{};
     }
 
     // 压缩内存池
-    static void ShrinkToFit(size_t min_free_blocks = 64)
+    static size_t ShrinkToFit(size_t min_free_blocks = 64, std::chrono::milliseconds handshake_timeout = std::chrono::milliseconds(10))
     {
-        pool_.ShrinkToFit(min_free_blocks);
+        MemoryPool* pool = pool_.load(std::memory_order_acquire);
+        return pool ? pool->ShrinkToFit(min_free_blocks, handshake_timeout) : 0;
     }
 
 private:
-    static ObjectPool<T> pool_;  // 静态对象池实例
-};
+    // allocate_shared使用的分配器，标准库会把它重绑定到内部的控制块类型U（包含T），
+    // 块大小只有在那时才知道，所以内存池在首次分配时按sizeof(U)创建
+    template <typename U>
+    class BlockAllocator
+    {
+    public:
+        using value_type = U;
 
-// 静态成员初始化
-template <typename T>
-ObjectPool<T> PooledSharedPtr<T>::pool_;
+        template <typename V>
+        struct rebind
+        {
+            using other = BlockAllocator<V>;
+        };
+
+        BlockAllocator() noexcept = default;
+
+        template <typename V>
+        BlockAllocator(const BlockAllocator<V>&) noexcept {}
+
+        U* allocate(size_t n)
+        {
+            if (n != 1)
+            {
+                return static_cast<U*>(operator new(n * sizeof(U), std::align_val_t(alignof(U))));
+            }
+
+            return static_cast<U*>(Pool<U>().Allocate());
+        }
+
+        void deallocate(U* ptr, size_t n) noexcept
+        {
+            if (n != 1)
+            {
+                operator delete(ptr, std::align_val_t(alignof(U)));
+                return;
+            }
+
+            Pool<U>().Deallocate(ptr);
+        }
+
+        template <typename V>
+        bool operator==(const BlockAllocator<V>&) const noexcept
+        {
+            return true;
+        }
+
+        template <typename V>
+        bool operator!=(const BlockAllocator<V>&) const noexcept
+        {
+            return false;
+        }
+    };
+
+    // 控制块类型U对应的内存池（永不析构，保证静态对象析构时持有的共享指针仍可安全释放）
+    template <typename U>
+    static MemoryPool& Pool()
+    {
+        static MemoryPool* pool = []
+        {
+            auto* created = new MemoryPool(sizeof(U), alignof(U));
+            pool_.store(created, std::memory_order_release);
+            return created;
+        }();
+        return *pool;
+    }
+
+    inline static std::atomic<MemoryPool*> pool_{nullptr};  // 控制块内存池，供统计和收缩使用
+};
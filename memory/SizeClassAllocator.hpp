@@ -0,0 +1,358 @@
+#pragma once
+
+#include "MemoryPool.hpp"
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <memory_resource>
+#include <new>
+
+// 多尺寸级别分配器
+// 按tcmalloc风格的尺寸级别（8~4096字节）把变长请求路由到一组MemoryPool，
+// 超过最大级别或对齐要求超过max_align_t的请求直接向系统申请
+class SizeClassAllocator
+{
+public:
+    static constexpr size_t kMinAlignment = alignof(std::max_align_t);   // 池化路径支持的最大对齐
+    static constexpr size_t kMaxSmallSize = 4096;                         // 池化路径支持的最大尺寸
+    static constexpr size_t kClassCount = 29;                             // 尺寸级别数量
+
+    // 构造函数
+    // thread_cache_size: 每个尺寸级别线程本地缓存的最大块数
+    // chunk_bytes: 每个尺寸级别每次扩展时申请的字节数
+    explicit SizeClassAllocator(size_t thread_cache_size = 32, size_t chunk_bytes = 64 * 1024)
+        : thread_cache_size_(thread_cache_size), chunk_bytes_(chunk_bytes)
+    {
+        for (auto& pool : pools_)
+        {
+            pool.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    // 析构函数，释放所有尺寸级别的内存池
+    ~SizeClassAllocator()
+    {
+        for (auto& pool : pools_)
+        {
+            delete pool.load(std::memory_order_acquire);
+        }
+    }
+
+    // 全局默认分配器（进程内共享，永不析构，保证静态对象析构时仍可安全归还内存）
+    static SizeClassAllocator& Default()
+    {
+        static SizeClassAllocator* instance = new SizeClassAllocator();
+        return *instance;
+    }
+
+    // 分配内存
+    // size: 请求字节数
+    // alignment: 对齐要求
+    void* Allocate(size_t size, size_t alignment = kMinAlignment)
+    {
+        const size_t index = ClassIndexFor(size, alignment);
+        if (index == kClassCount)
+        {
+            large_allocations_.fetch_add(1, std::memory_order_relaxed);
+            large_bytes_.fetch_add(size, std::memory_order_relaxed);
+            return operator new(size, std::align_val_t(std::max(alignment, kMinAlignment)));
+        }
+
+        return GetPool(index).Allocate();
+    }
+
+    // 回收内存，size和alignment必须与分配时一致
+    void Deallocate(void* ptr, size_t size, size_t alignment = kMinAlignment)
+    {
+        if (!ptr) return;
+
+        const size_t index = ClassIndexFor(size, alignment);
+        if (index == kClassCount)
+        {
+            large_allocations_.fetch_sub(1, std::memory_order_relaxed);
+            large_bytes_.fetch_sub(size, std::memory_order_relaxed);
+            operator delete(ptr, std::align_val_t(std::max(alignment, kMinAlignment)));
+            return;
+        }
+
+        // 能走到这里说明分配时该级别的内存池已经创建
+        pools_[index].load(std::memory_order_acquire)->Deallocate(ptr);
+    }
+
+    // 释放各尺寸级别完全空闲的内存块，返回释放的chunk总数
+    size_t ShrinkToFit(size_t min_free_blocks = 64, std::chrono::milliseconds handshake_timeout = std::chrono::milliseconds(10))
+    {
+        size_t released = 0;
+        for (auto& pool : pools_)
+        {
+            if (MemoryPool* p = pool.load(std::memory_order_acquire))
+            {
+                released += p->ShrinkToFit(min_free_blocks, handshake_timeout);
+            }
+        }
+        return released;
+    }
+
+    // 获取所有尺寸级别汇总后的内存统计信息（不含大块分配，峰值为各级别峰值之和）
+    MemoryStats GetStats() const
+    {
+        MemoryStats total;
+        total.timestamp = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < kClassCount; ++i)
+        {
+            MemoryStats stats = GetClassStats(i);
+            total.allocated_blocks += stats.allocated_blocks;
+            total.free_blocks += stats.free_blocks;
+            total.total_chunks += stats.total_chunks;
+            total.total_memory += stats.total_memory;
+            total.thread_cache_blocks += stats.thread_cache_blocks;
+            total.thread_cache_capacity += stats.thread_cache_capacity;
+            total.peak_in_use_blocks += stats.peak_in_use_blocks;
+            total.allocations += stats.allocations;
+            total.deallocations += stats.deallocations;
+            total.refills += stats.refills;
+            total.returns += stats.returns;
+            total.central_lock_waits += stats.central_lock_waits;
+            total.central_lock_wait_ns += stats.central_lock_wait_ns;
+        }
+
+        return total;
+    }
+
+    // 获取单个尺寸级别的内存统计信息（该级别尚未使用时返回空统计）
+    MemoryStats GetClassStats(size_t class_index) const
+    {
+        MemoryPool* pool = pools_[class_index].load(std::memory_order_acquire);
+        return pool ? pool->GetStats() : MemoryStats{};
+    }
+
+    // 当前仍未释放的大块分配数量
+    size_t GetLargeAllocations() const
+    {
+        return large_allocations_.load(std::memory_order_relaxed);
+    }
+
+    // 当前仍未释放的大块分配字节数
+    size_t GetLargeBytes() const
+    {
+        return large_bytes_.load(std::memory_order_relaxed);
+    }
+
+    // 指定尺寸级别的块大小
+    static size_t ClassSize(size_t class_index)
+    {
+        return Tables().class_sizes[class_index];
+    }
+
+    // 计算请求对应的尺寸级别，返回kClassCount表示走大块路径
+    static size_t ClassIndexFor(size_t size, size_t alignment = kMinAlignment)
+    {
+        if (alignment > kMinAlignment)
+        {
+            return kClassCount;
+        }
+
+        // 除8字节级别外所有级别都是16的倍数，对齐要求超过8时至少落到16字节级别
+        size = std::max(size, alignment);
+        if (size > kMaxSmallSize)
+        {
+            return kClassCount;
+        }
+
+        const auto& tables = Tables();
+        if (size <= 1024)
+        {
+            return tables.small_index[(size + 7) >> 3];
+        }
+
+        return tables.large_index[(size + 127) >> 7];
+    }
+
+    // 禁用拷贝和赋值
+    SizeClassAllocator(const SizeClassAllocator&) = delete;
+    SizeClassAllocator& operator=(const SizeClassAllocator&) = delete;
+
+private:
+    // 尺寸级别表和查找表
+    struct SizeClassTables
+    {
+        std::array<size_t, kClassCount> class_sizes{};
+        std::array<uint8_t, (1024 >> 3) + 1> small_index{};         // 1~1024字节，8字节粒度
+        std::array<uint8_t, (kMaxSmallSize >> 7) + 1> large_index{};  // 1025~4096字节，128字节粒度
+    };
+
+    // 生成尺寸级别：8、16、32~128按16递增，之后每翻一倍划分4个级别
+    static const SizeClassTables& Tables()
+    {
+        static const SizeClassTables tables = []
+        {
+            SizeClassTables t;
+            size_t count = 0;
+            t.class_sizes[count++] = 8;
+            for (size_t size = 16; size <= 128; size += 16)
+            {
+                t.class_sizes[count++] = size;
+            }
+
+            for (size_t base = 128; base < kMaxSmallSize; base *= 2)
+            {
+                for (size_t step = 1; step <= 4; ++step)
+                {
+                    t.class_sizes[count++] = base + base / 4 * step;
+                }
+            }
+
+            size_t index = 0;
+            for (size_t i = 0; i < t.small_index.size(); ++i)
+            {
+                while (t.class_sizes[index] < (i << 3))
+                {
+                    ++index;
+                }
+                t.small_index[i] = static_cast<uint8_t>(index);
+            }
+
+            for (size_t i = 0; i < t.large_index.size(); ++i)
+            {
+                while (t.class_sizes[index] < (i << 7))
+                {
+                    ++index;
+                }
+                t.large_index[i] = static_cast<uint8_t>(index);
+            }
+
+            return t;
+        }();
+
+        return tables;
+    }
+
+    // 获取尺寸级别对应的内存池，首次使用时才创建，避免未使用的级别占用内存
+    MemoryPool& GetPool(size_t index)
+    {
+        MemoryPool* pool = pools_[index].load(std::memory_order_acquire);
+        if (pool)
+        {
+            return *pool;
+        }
+
+        std::lock_guard<std::mutex> lock(create_mutex_);
+        pool = pools_[index].load(std::memory_order_relaxed);
+        if (!pool)
+        {
+            const size_t size = ClassSize(index);
+            const size_t alignment = std::min(size, kMinAlignment);
+            const size_t chunk_block_count = std::max<size_t>(chunk_bytes_ / size, 8);
+
+            // 大尺寸级别使用更小的线程缓存，限制每个线程缓存占用的字节数
+            const size_t cache_size = std::clamp<size_t>(kThreadCacheBytes / size, 4, std::max<size_t>(thread_cache_size_, 4));
+
+            pool = new MemoryPool(size, alignment, cache_size, chunk_block_count);
+            pools_[index].store(pool, std::memory_order_release);
+        }
+
+        return *pool;
+    }
+
+    static constexpr size_t kThreadCacheBytes = 32 * 1024;    // 单个级别线程缓存的字节上限
+
+    size_t thread_cache_size_;                                  // 线程缓存块数上限
+    size_t chunk_bytes_;                                        // 每次扩展的字节数
+    std::array<std::atomic<MemoryPool*>, kClassCount> pools_;   // 各尺寸级别的内存池
+    std::mutex create_mutex_;                                   // 创建内存池时使用的互斥锁
+
+    std::atomic<size_t> large_allocations_{0};                  // 大块分配数量
+    std::atomic<size_t> large_bytes_{0};                        // 大块分配字节数
+};
+
+// 基于SizeClassAllocator的std::pmr内存资源
+// 可直接用于std::pmr::string、std::pmr::vector、std::pmr::map等容器
+class PoolMemoryResource : public std::pmr::memory_resource
+{
+public:
+    explicit PoolMemoryResource(SizeClassAllocator& allocator = SizeClassAllocator::Default())
+        : allocator_(&allocator) {}
+
+    // 获取底层分配器
+    SizeClassAllocator& GetAllocator() const
+    {
+        return *allocator_;
+    }
+
+    // 全局默认内存资源
+    static PoolMemoryResource* Default()
+    {
+        static PoolMemoryResource* instance = new PoolMemoryResource();
+        return instance;
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        return allocator_->Allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        allocator_->Deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        auto* rhs = dynamic_cast<const PoolMemoryResource*>(&other);
+        return rhs && rhs->allocator_ == allocator_;
+    }
+
+private:
+    SizeClassAllocator* allocator_;  // 底层分配器
+};
+
+// 基于SizeClassAllocator的STL分配器适配器
+// 用法：std::list<int, PoolAllocator<int>>、std::basic_string<char, std::char_traits<char>, PoolAllocator<char>>
+template <typename T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept : allocator_(&SizeClassAllocator::Default()) {}
+    explicit PoolAllocator(SizeClassAllocator& allocator) noexcept : allocator_(&allocator) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : allocator_(&other.GetAllocator()) {}
+
+    T* allocate(size_t n)
+    {
+        if (n > static_cast<size_t>(-1) / sizeof(T))
+        {
+            throw std::bad_array_new_length();
+        }
+
+        return static_cast<T*>(allocator_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        allocator_->Deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    SizeClassAllocator& GetAllocator() const noexcept
+    {
+        return *allocator_;
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept
+    {
+        return allocator_ == &other.GetAllocator();
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    SizeClassAllocator* allocator_;  // 底层分配器
+};
@@ -5,6 +5,7 @@
 #include "rpc_router.hpp"
 #include "string_resize.hpp"
 #include "use_asio.hpp"
+#include <memory_resource>
 
 namespace rest_rpc
 {
@@ -45,6 +46,35 @@ namespace rest_rpc
 		return instance;
 	}
 
+	// 每个连接的请求临时内存区：连接在路由每个请求前调用reset()
+	class request_arena
+	{
+	public:
+		virtual ~request_arena() = default;
+		virtual std::pmr::memory_resource* resource() = 0;
+		virtual void reset() = 0;
+	};
+
+	// 把提供Reset()的pmr内存资源（如MonotonicArena）包装成request_arena：
+	// server.set_arena_factory([] { return std::make_unique<rest_rpc::basic_request_arena<MonotonicArena>>(); });
+	template <typename Arena>
+	class basic_request_arena : public request_arena
+	{
+	public:
+		std::pmr::memory_resource* resource() override
+		{
+			return &arena_;
+		}
+
+		void reset() override
+		{
+			arena_.Reset();
+		}
+
+	private:
+		Arena arena_;
+	};
+
 	class rpc_context
 	{
 	public:
@@ -130,6 +160,10 @@ namespace rest_rpc
 				}
 
 				// route
+				if (arena_)
+				{
+					arena_->reset();
+				}
 				get_context().set_connection(self);
 				auto result = co_await router_.route(header.function_id, body_);
 				bool delay = get_context().delay();
@@ -245,6 +279,23 @@ namespace rest_rpc
 			checkout_timeout_ = r;
 		}
 
+		void set_arena(std::unique_ptr<request_arena> arena)
+		{
+			arena_ = std::move(arena);
+		}
+
+		// 当前请求的临时内存区，handler中的临时对象可用std::pmr容器从这里分配。
+		// get_context()是线程局部的，handler挂起后可能被同一io线程上的其他连接改写，
+		// 必须在第一个co_await之前取出连接或内存区：
+		// auto arena = rest_rpc::get_context().get_conn()->arena();
+		// std::pmr::string s(arena);
+		// 内存区在同一连接收到下一个请求时清空，延迟响应（rpc_context）不能引用其中的对象
+		// 未设置内存区时返回默认内存资源
+		std::pmr::memory_resource* arena()
+		{
+			return arena_ ? arena_->resource() : std::pmr::get_default_resource();
+		}
+
 	private:
 		tcp_socket socket_;
 		uint64_t conn_id_;
@@ -256,6 +307,7 @@ namespace rest_rpc
 		rpc_router& router_;
 		bool cross_ending_;
 		std::atomic<uint32_t> topic_id_;
+		std::unique_ptr<request_arena> arena_; // 每个请求的临时内存区（可选）
 	};
 
 	auto tls_data::get_executor()
@@ -132,6 +132,12 @@ namespace rest_rpc
 			cross_ending_ = r;
 		}
 
+		// 为每个新连接创建请求临时内存区，见rpc_connection::arena()
+		void set_arena_factory(std::function<std::unique_ptr<request_arena>()> factory)
+		{
+			arena_factory_ = std::move(factory);
+		}
+
 		size_t connection_count()
 		{
 			std::scoped_lock lock(*conn_mtx_);
@@ -234,6 +240,11 @@ namespace rest_rpc
 					conn->set_check_timeout(true);
 				}
 
+				if (arena_factory_)
+				{
+					conn->set_arena(arena_factory_());
+				}
+
 				std::weak_ptr<std::mutex> weak(conn_mtx_);
 				conn->set_quit_callback([this, weak](const uint64_t& id)
 					{
@@ -353,5 +364,6 @@ namespace rest_rpc
 		rpc_router router_;
 		bool tcp_no_delay_ = true;
 		bool cross_ending_ = false;
+		std::function<std::unique_ptr<request_arena>()> arena_factory_ = nullptr;
 	};
 } // namespace rest_rpc
\ No newline at end of file
@@ -2,12 +2,11 @@
 
 #include "ThreadPool.hpp"
 
-static ThreadPool global_thread_pool(64);
-
 class Object
 {
 public:
-    Object() : m_threadPool(&global_thread_pool) {}
+    // 默认不绑定线程池，异步槽在发射时才交给全局执行器（GlobalExecutor），第一次使用时才创建线程
+    Object() : m_threadPool(nullptr) {}
     virtual ~Object() = default;
 
     Object(const Object &) = delete;
@@ -21,6 +20,7 @@ public:
         }
     }
 
+    // 返回nullptr表示使用全局执行器
     ThreadPool *getThreadPool() const
     {
         return m_threadPool;
@@ -11,6 +11,7 @@
 #include "Connection.hpp"
 #include "Object.h"
 #include "ThreadPool.hpp"
+#include "GlobalExecutor.hpp"
 
 template<typename... SignalArgs>
 class Signal
@@ -22,7 +23,7 @@ private:
         std::function<void(SignalArgs...)> slot;
         std::shared_ptr<typename Connection<SignalArgs...>::ConnectionData> connection_data;
         size_t id;
-        ThreadPool *target_thread_pool; // 接收者关联的线程池
+        ThreadPool *target_thread_pool; // 接收者关联的线程池，nullptr表示全局执行器
     };
 
     mutable std::shared_mutex mutex_;
@@ -124,8 +125,8 @@ public:
                 // 2. 移动参数打包成的 tuple
                 auto args_tuple = std::make_tuple(std::forward<SignalArgs>(args)...);
 
-                // 3. 确定目标线程池
-                ThreadPool* target_pool = slot_info.target_thread_pool ? slot_info.target_thread_pool : &global_thread_pool;
+                // 3. 确定目标线程池（全局执行器在第一次异步发射时才创建）
+                ThreadPool* target_pool = slot_info.target_thread_pool;
 
                 // 4. 创建最终的无参任务 lambda 捕获所有需要的数据
                 auto task = [slot_copy = std::move(slot_copy), args_tuple = std::move(args_tuple)]() mutable
@@ -144,7 +145,7 @@ public:
                 // 6. 将这个无参任务提交到正确的线程池
                 try
                 {
-                    target_pool->push(std::move(task));
+                    (target_pool ? *target_pool : GlobalExecutor::instance()).push(std::move(task));
                 }
                 catch(const std::exception& e)
                 {
@@ -0,0 +1,418 @@
+#ifndef COROUTINE_HPP
+#define COROUTINE_HPP
+
+/**
+ * C++20 协程支持：CoTask<T> 协程类型，以及 ThreadPool / ThreadExecutor 的 schedule()、post_awaitable() 使用的等待体。
+ * 编译器不支持协程（如按 C++17 编译）时本文件为空，THREAD_HAS_COROUTINES 为 0。
+ */
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define THREAD_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifndef THREAD_HAS_COROUTINES
+#define THREAD_HAS_COROUTINES 0
+#endif
+
+#if THREAD_HAS_COROUTINES
+
+#include <atomic>
+#include <coroutine>
+#include <cstdio>
+#include <exception>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+template <typename T = void>
+class CoTask;
+
+/**
+ * @brief CoTask 的 promise 公共部分：惰性启动，结束时把执行权交还给等待者
+ *
+ * 等待者与协程通过 ready_ 交接：协程同步执行完时等待者直接继续，不嵌套恢复，
+ * 循环 co_await 大量同步完成的任务也不会随次数增加栈深度（不依赖编译器把对称转移优化成尾调用）。
+ */
+class CoTaskPromiseBase
+{
+public:
+    /**
+     * @brief 协程结束时挂起在终点（由 CoTask 析构时销毁）；等待者已经挂起时恢复等待者
+     */
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            CoTaskPromiseBase& promise = handle.promise();
+            if (promise.ready_.exchange(true, std::memory_order_acq_rel) && promise.continuation_)
+            {
+                return promise.continuation_;   // 等待者已挂起，由这里恢复
+            }
+            return std::noop_coroutine();       // 同步完成，等待者的 await_suspend 返回后直接继续
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception() noexcept
+    {
+        exception_ = std::current_exception();
+    }
+
+    std::coroutine_handle<> continuation_;  // co_await 本任务的协程
+    std::exception_ptr exception_;          // 协程体抛出的异常
+    std::atomic<bool> ready_{false};        // 等待者挂起与协程结束中先到的一方置为true，后到的一方负责继续执行等待者
+};
+
+template <typename T>
+class CoTaskPromise : public CoTaskPromiseBase
+{
+public:
+    CoTask<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& value)
+    {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    T result()
+    {
+        if (exception_)
+        {
+            std::rethrow_exception(exception_);
+        }
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;    // co_return 的值
+};
+
+template <>
+class CoTaskPromise<void> : public CoTaskPromiseBase
+{
+public:
+    CoTask<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void result()
+    {
+        if (exception_)
+        {
+            std::rethrow_exception(exception_);
+        }
+    }
+};
+
+/**
+ * @brief 惰性启动的协程任务
+ *
+ * 创建后不执行，被 co_await 时才在等待者所在线程上开始执行；结束后在结束所在的线程上继续执行等待者。
+ * 协程体内用 co_await pool.schedule() 切换到线程池，用 co_await executor.schedule() 切回执行器线程。
+ * 在普通函数中用 sync_wait() 阻塞等待结果，或用 start_detached() 启动后不再等待。
+ *
+ * @tparam T 返回值类型
+ */
+template <typename T>
+class CoTask
+{
+public:
+    using promise_type = CoTaskPromise<T>;
+
+    CoTask() noexcept = default;
+
+    explicit CoTask(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    CoTask(CoTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    CoTask& operator=(CoTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    ~CoTask()
+    {
+        if (handle_)
+        {
+            handle_.destroy();
+        }
+    }
+
+    /**
+     * @brief 是否持有协程
+     */
+    bool valid() const noexcept
+    {
+        return static_cast<bool>(handle_);
+    }
+
+    /**
+     * @brief 协程是否已执行完
+     */
+    bool is_ready() const noexcept
+    {
+        return !handle_ || handle_.done();
+    }
+
+    /**
+     * @brief co_await 时启动协程，结束后返回结果或重新抛出异常
+     */
+    auto operator co_await() const noexcept
+    {
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept
+            {
+                return !handle || handle.done();
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaiting)
+            {
+                handle.promise().continuation_ = awaiting;
+                handle.resume(); // 执行到第一次挂起或结束
+                return !handle.promise().ready_.exchange(true, std::memory_order_acq_rel); // 已结束则不挂起
+            }
+
+            T await_resume()
+            {
+                return handle.promise().result();
+            }
+        };
+
+        return Awaiter{handle_};
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename T>
+CoTask<T> CoTaskPromise<T>::get_return_object() noexcept
+{
+    return CoTask<T>(std::coroutine_handle<CoTaskPromise<T>>::from_promise(*this));
+}
+
+inline CoTask<void> CoTaskPromise<void>::get_return_object() noexcept
+{
+    return CoTask<void>(std::coroutine_handle<CoTaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief 立即启动、结束时自行销毁的协程，用于 sync_wait() 和 start_detached()
+ */
+struct CoDetached
+{
+    struct promise_type
+    {
+        CoDetached get_return_object() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+/**
+ * @brief 驱动协程：等待 task 结束后把结果写入 promise
+ */
+template <typename T>
+CoDetached co_task_drive(CoTask<T> task, std::promise<T>& promise)
+{
+    try
+    {
+        if constexpr (std::is_void<T>::value)
+        {
+            co_await task;
+            promise.set_value();
+        }
+        else
+        {
+            promise.set_value(co_await task);
+        }
+    }
+    catch (...)
+    {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+/**
+ * @brief 在当前线程启动 task 并阻塞等待结果（task 切换到其他线程后，当前线程只等待）
+ *
+ * 不要在 task 需要的线程池或执行器线程上调用，否则可能自己等自己。
+ *
+ * @return task 的结果
+ * @throw task 抛出的异常
+ */
+template <typename T>
+T sync_wait(CoTask<T> task)
+{
+    std::promise<T> promise;
+    std::future<T> future = promise.get_future();
+    co_task_drive(std::move(task), promise);
+    return future.get();
+}
+
+/**
+ * @brief 在当前线程启动 task，不等待结果；task 抛出的异常打印后丢弃
+ */
+inline void start_detached(CoTask<void> task)
+{
+    [](CoTask<void> owned) -> CoDetached
+    {
+        try
+        {
+            co_await owned;
+        }
+        catch (const std::exception& e)
+        {
+            fprintf(stderr, "Detached coroutine failed: %s\n", e.what());
+        }
+        catch (...)
+        {
+            fprintf(stderr, "Detached coroutine failed: unknown exception\n");
+        }
+    }(std::move(task));
+}
+
+/**
+ * @brief co_await 后在 post 提交到的线程上继续执行
+ * @tparam Post 可调用对象，接收一个无参可调用对象并把它提交给目标线程，提交失败时抛出异常
+ */
+template <typename Post>
+class ScheduleAwaiter
+{
+public:
+    explicit ScheduleAwaiter(Post post) : post_(std::move(post)) {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        post_([handle]() { handle.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    Post post_;
+};
+
+/**
+ * @brief co_await 时把 f 提交到目标线程执行，等待期间不占用任何线程，执行完在目标线程上以 f 的返回值恢复
+ * @tparam Post 同 ScheduleAwaiter
+ * @tparam F 无参可调用对象
+ */
+template <typename Post, typename F>
+class CallAwaiter
+{
+public:
+    using ResultType = std::invoke_result_t<F&>;
+
+    CallAwaiter(Post post, F f) : post_(std::move(post)), f_(std::move(f)) {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        // 等待体位于挂起的协程帧内，恢复前一直有效
+        post_([this, handle]()
+              {
+                  try
+                  {
+                      if constexpr (std::is_void<ResultType>::value)
+                      {
+                          f_();
+                      }
+                      else
+                      {
+                          result_.emplace(f_());
+                      }
+                  }
+                  catch (...)
+                  {
+                      exception_ = std::current_exception();
+                  }
+                  handle.resume();
+              });
+    }
+
+    ResultType await_resume()
+    {
+        if (exception_)
+        {
+            std::rethrow_exception(exception_);
+        }
+        if constexpr (!std::is_void<ResultType>::value)
+        {
+            return std::move(*result_);
+        }
+    }
+
+private:
+    using Storage = std::conditional_t<std::is_void<ResultType>::value, bool, std::optional<ResultType>>;
+
+    Post post_;
+    F f_;
+    Storage result_{};
+    std::exception_ptr exception_;
+};
+
+#endif // THREAD_HAS_COROUTINES
+
+#endif // COROUTINE_HPP
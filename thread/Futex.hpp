@@ -0,0 +1,222 @@
+#ifndef FUTEX_HPP
+#define FUTEX_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#else
+#include <mutex>
+#include <condition_variable>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief 自旋等待时提示CPU降低功耗、让出超线程资源
+ */
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief 事件计数器（eventcount），无锁数据结构上的阻塞等待原语
+ *
+ * 等待方：key = prepare_wait() → 重新检查条件 → 条件满足则cancel_wait()，否则wait(key)
+ * 通知方：先让条件成立，再notify_one()/notify_all()
+ * 没有等待者时通知只有一次内存屏障和一次读取，不进入内核；Linux下用futex休眠，其他平台退化为条件变量
+ */
+class EventCount
+{
+public:
+    /**
+     * @brief 登记为等待者并返回当前事件序号
+     * @return 传给wait的序号
+     */
+    uint32_t prepare_wait()
+    {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief 重新检查发现条件已满足，撤销登记
+     */
+    void cancel_wait()
+    {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 休眠直到prepare_wait之后有通知、超时或虚假唤醒
+     * @param key prepare_wait的返回值
+     * @param timeout 最长休眠时间
+     */
+    void wait(uint32_t key, std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max())
+    {
+#if defined(__linux__)
+        if (epoch_.load(std::memory_order_acquire) == key)
+        {
+            timespec ts;
+            timespec* ts_ptr = nullptr;
+            if (timeout != std::chrono::nanoseconds::max())
+            {
+                ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+                ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+                ts_ptr = &ts;
+            }
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE, key, ts_ptr, nullptr, 0);
+        }
+#else
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto changed = [this, key] { return epoch_.load(std::memory_order_acquire) != key; };
+        if (timeout == std::chrono::nanoseconds::max())
+        {
+            cond_.wait(lock, changed);
+        }
+        else
+        {
+            cond_.wait_for(lock, timeout, changed);
+        }
+#endif
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 先自旋、再让出、最后休眠，直到条件成立或超时
+     * @param condition 条件检查（可以带副作用，例如尝试出队，返回true表示成功）
+     * @param timeout 最长等待时间（nanoseconds::max()表示不超时）
+     * @param park 是否允许休眠；通知方不调用notify时传false，只自旋和让出
+     * @return 条件是否成立
+     */
+    template <typename Condition>
+    bool await(Condition&& condition, std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max(), bool park = true)
+    {
+        constexpr int kSpinCount = 128;     // 休眠前的自旋次数
+        constexpr int kYieldCount = 4;      // 自旋后休眠前的让出次数
+
+        for (int i = 0; i < kSpinCount + kYieldCount; ++i)
+        {
+            if (condition())
+            {
+                return true;
+            }
+
+            if (i < kSpinCount)
+            {
+                cpu_relax();
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        const bool forever = timeout == std::chrono::nanoseconds::max();
+        const auto deadline = forever ? std::chrono::steady_clock::time_point::max() : std::chrono::steady_clock::now() + timeout;
+        while (true)
+        {
+            if (!park)
+            {
+                if (condition())
+                {
+                    return true;
+                }
+                if (!forever && std::chrono::steady_clock::now() >= deadline)
+                {
+                    return false;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+
+            const uint32_t key = prepare_wait();
+            if (condition())
+            {
+                cancel_wait();
+                return true;
+            }
+
+            if (forever)
+            {
+                wait(key);
+                continue;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                cancel_wait();
+                return condition();
+            }
+            wait(key, deadline - now);
+        }
+    }
+
+    /**
+     * @brief 唤醒一个等待者
+     */
+    void notify_one()
+    {
+        notify(1);
+    }
+
+    /**
+     * @brief 唤醒所有等待者
+     */
+    void notify_all()
+    {
+        notify(INT32_MAX);
+    }
+
+private:
+    void notify(int count)
+    {
+        // 与prepare_wait中的seq_cst操作配对：要么等待方重新检查时看到条件成立，要么这里看到等待者
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0)
+        {
+            return;
+        }
+
+#if defined(__linux__)
+        epoch_.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            epoch_.fetch_add(1, std::memory_order_release);
+        }
+        if (count == 1)
+        {
+            cond_.notify_one();
+        }
+        else
+        {
+            cond_.notify_all();
+        }
+#endif
+    }
+
+    std::atomic<uint32_t> epoch_{0};        // 事件序号（futex字）
+    std::atomic<uint32_t> waiters_{0};      // 已登记的等待者数量
+#if !defined(__linux__)
+    std::mutex mutex_;                      // 非Linux平台的休眠实现
+    std::condition_variable cond_;
+#endif
+};
+
+#endif // FUTEX_HPP
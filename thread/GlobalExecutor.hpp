@@ -0,0 +1,146 @@
+#ifndef GLOBAL_EXECUTOR_HPP
+#define GLOBAL_EXECUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include "ThreadPool.hpp"
+
+/**
+ * @brief 进程内共享的全局线程池，第一次使用时才创建
+ *
+ * 头文件里的 static ThreadPool 会在每个包含它的编译单元各创建一份，main 之前就启动所有线程；
+ * 这里整个进程只有一个实例（C++17 inline 变量），instance() 第一次调用时才启动线程。
+ * 默认线程数为 hardware_concurrency（至少2个），可在第一次使用前用 configure() 改成固定线程数或弹性伸缩。
+ * 进程退出时自动 shutdown()：执行完已提交的任务后 join 所有线程。
+ */
+class GlobalExecutor
+{
+public:
+    /**
+     * @brief 获取全局线程池，第一次调用时创建
+     * @throw std::runtime_error 已经 shutdown()
+     */
+    static ThreadPool& instance()
+    {
+        if (ThreadPool* pool = pool_.load(std::memory_order_acquire))
+        {
+            return *pool;
+        }
+
+        return create();
+    }
+
+    /**
+     * @brief 第一次使用前指定固定线程数
+     * @return 已经创建（或已关闭）时返回 false，配置不生效
+     */
+    static bool configure(size_t threads)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (created_)
+        {
+            return false;
+        }
+
+        threads_ = std::max<size_t>(1, threads);
+        elastic_config_.reset();
+        return true;
+    }
+
+    /**
+     * @brief 第一次使用前配置为弹性线程池
+     * @return 已经创建（或已关闭）时返回 false，配置不生效
+     */
+    static bool configure(const ThreadPoolElasticConfig& config)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (created_)
+        {
+            return false;
+        }
+
+        elastic_config_ = config;
+        return true;
+    }
+
+    /**
+     * @brief 全局线程池是否已经创建（不会触发创建）
+     */
+    static bool created()
+    {
+        return pool_.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /**
+     * @brief 有序关闭：不再接受新的 instance() 调用，执行完已提交的任务后 join 所有线程
+     *
+     * 调用方需保证此时没有其他线程仍在使用 instance() 返回的引用。重复调用无副作用。
+     */
+    static void shutdown()
+    {
+        std::unique_ptr<ThreadPool> pool;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            created_ = true;
+            shut_down_ = true;
+            pool = std::move(owner_);
+            pool_.store(nullptr, std::memory_order_release);
+        }
+    }
+
+private:
+    /**
+     * @brief 进程退出时关闭全局线程池
+     */
+    struct ExitGuard
+    {
+        ~ExitGuard()
+        {
+            shutdown();
+        }
+    };
+
+    static ThreadPool& create()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (shut_down_)
+        {
+            throw std::runtime_error("GlobalExecutor has been shut down");
+        }
+
+        if (!owner_)
+        {
+            // 退出守卫在第一次创建时构造，析构早于在它之前构造完成的静态对象，排空任务时这些对象仍然有效
+            static ExitGuard exit_guard;
+
+            if (elastic_config_)
+            {
+                owner_ = std::make_unique<ThreadPool>(*elastic_config_);
+            }
+            else
+            {
+                owner_ = std::make_unique<ThreadPool>(threads_ ? threads_ : std::max<size_t>(2, std::thread::hardware_concurrency()));
+            }
+
+            created_ = true;
+            pool_.store(owner_.get(), std::memory_order_release);
+        }
+
+        return *owner_;
+    }
+
+    inline static std::atomic<ThreadPool*> pool_{nullptr};      // 快速路径读取的线程池指针
+    inline static std::mutex mutex_;                            // 保护以下成员
+    inline static std::unique_ptr<ThreadPool> owner_;           // 线程池
+    inline static bool created_ = false;                        // 是否已创建过（之后不能再配置）
+    inline static bool shut_down_ = false;                      // 是否已关闭
+    inline static size_t threads_ = 0;                          // 固定线程数，0表示按硬件并发数
+    inline static std::optional<ThreadPoolElasticConfig> elastic_config_;  // 弹性配置，为空表示固定线程数
+};
+
+#endif // GLOBAL_EXECUTOR_HPP
@@ -0,0 +1,232 @@
+#ifndef MPMC_QUEUE_HPP
+#define MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "Futex.hpp"
+
+/**
+ * @brief 有界无锁多生产者多消费者队列（Vyukov序号环形缓冲区）
+ *
+ * 每个槽位带一个序号，生产者/消费者各自用CAS抢占位置，再根据槽位序号判断可写/可读，全程无锁、无动态分配。
+ * 接口与ThreadSafeQueue一致（push/try_pop/wait_pop），另提供非阻塞的try_push。
+ * 阻塞操作先短暂自旋，仍不满足再通过futex休眠，空闲时不占CPU。
+ *
+ * @tparam T 队列元素类型（需支持移动）
+ */
+template <typename T>
+class MpmcQueue
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity 队列容量（向上取整为2的幂，最小2）
+     */
+    explicit MpmcQueue(size_t capacity = 1024)
+    {
+        capacity_ = 2;
+        while (capacity_ < capacity)
+        {
+            capacity_ <<= 1;
+        }
+        mask_ = capacity_ - 1;
+
+        cells_.reset(new Cell[capacity_]);
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief 析构函数（销毁队列中剩余元素，调用时不能有其他线程在访问队列）
+     */
+    ~MpmcQueue()
+    {
+        while (try_pop())
+        {
+        }
+    }
+
+    /**
+     * @brief 拷贝入队（阻塞直到有空间）
+     * @param value 待入队元素
+     * @return 总是返回true
+     */
+    bool push(const T& value)
+    {
+        return push(T(value));
+    }
+
+    /**
+     * @brief 移动入队（阻塞直到有空间）
+     * @param value 待入队元素（右值引用）
+     * @return 总是返回true
+     */
+    bool push(T&& value)
+    {
+        not_full_.await([this, &value] { return try_push(std::move(value)); });
+        return true;
+    }
+
+    /**
+     * @brief 尝试非阻塞入队
+     * @param value 待入队元素（失败时不会被移走）
+     * @return 成功返回true，队列满返回false
+     */
+    bool try_push(T&& value)
+    {
+        Cell* cell = nullptr;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                // 槽位空闲，抢占该位置
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // 槽位还没被消费者取走，队列满
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (&cell->storage) T(std::move(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        not_empty_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief 尝试非阻塞拷贝入队
+     * @param value 待入队元素
+     * @return 成功返回true，队列满返回false
+     */
+    bool try_push(const T& value)
+    {
+        T copy(value);
+        return try_push(std::move(copy));
+    }
+
+    /**
+     * @brief 尝试非阻塞出队
+     * @return 包含元素的std::optional（队列空时返回std::nullopt）
+     */
+    std::optional<T> try_pop()
+    {
+        Cell* cell = nullptr;
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // 槽位还没被生产者写入，队列空
+                return std::nullopt;
+            }
+            else
+            {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* item = std::launder(reinterpret_cast<T*>(&cell->storage));
+        std::optional<T> value(std::move(*item));
+        item->~T();
+        // 槽位留给下一圈的生产者
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        not_full_.notify_one();
+        return value;
+    }
+
+    /**
+     * @brief 阻塞出队（带超时）
+     * @param timeout 最大等待时间（默认10秒）
+     * @return 包含元素的std::optional（超时返回std::nullopt）
+     */
+    std::optional<T> wait_pop(std::chrono::milliseconds timeout = std::chrono::seconds(10))
+    {
+        std::optional<T> value;
+        not_empty_.await([this, &value] { value = try_pop(); return value.has_value(); }, timeout);
+        return value;
+    }
+
+    /**
+     * @brief 检查队列是否为空（并发修改时仅为近似值）
+     * @return true为空，false非空
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief 获取队列大小（并发修改时仅为近似值）
+     * @return 队列当前元素数量
+     */
+    size_t size() const
+    {
+        const size_t head = dequeue_pos_.load(std::memory_order_acquire);
+        const size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    /**
+     * @brief 获取队列容量
+     */
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    // 禁用拷贝和赋值
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    /**
+     * @brief 槽位：序号 + 元素存储，按缓存行对齐，避免相邻槽位的生产者和消费者伪共享
+     */
+    struct alignas(kCacheLineSize) Cell
+    {
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    std::unique_ptr<Cell[]> cells_;                                // 环形缓冲区
+    size_t capacity_;                                              // 容量（2的幂）
+    size_t mask_;                                                  // capacity_ - 1
+    alignas(kCacheLineSize) std::atomic<size_t> enqueue_pos_{0};   // 下一个写入位置（独占缓存行）
+    alignas(kCacheLineSize) std::atomic<size_t> dequeue_pos_{0};   // 下一个读取位置（独占缓存行）
+    alignas(kCacheLineSize) EventCount not_empty_;                 // 消费者等待
+    alignas(kCacheLineSize) EventCount not_full_;                  // 生产者等待
+};
+
+#endif // MPMC_QUEUE_HPP
@@ -0,0 +1,353 @@
+#ifndef PARALLEL_ALGORITHMS_HPP
+#define PARALLEL_ALGORITHMS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include "Futex.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @brief 并行算法的分块执行器（内部使用）
+ *
+ * 把工作切成chunk_count块，由调用线程和最多thread_count()个线程池任务共同从原子下标上领取执行。
+ * 调用线程自己也干活，并且只等待已被领走的块，所以在线程池工作线程里嵌套调用也不会死锁；
+ * 领到块之前就已经没活的辅助任务直接退出。任一块抛出异常后其余未开始的块被跳过，异常在调用线程重新抛出。
+ */
+class ParallelChunkRunner
+{
+public:
+    template <typename Body>
+    static void run(ThreadPool& pool, size_t chunk_count, Body& body)
+    {
+        if (chunk_count == 0)
+        {
+            return;
+        }
+
+        const size_t helpers = std::min(chunk_count - 1, pool.thread_count());
+        if (helpers == 0)
+        {
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+            {
+                body(chunk);
+            }
+            return;
+        }
+
+        auto state = std::make_shared<State>();
+        state->chunk_count = chunk_count;
+        state->body = &body;
+        state->invoke = [](void* target, size_t chunk) { (*static_cast<Body*>(target))(chunk); };
+
+        for (size_t i = 0; i < helpers; ++i)
+        {
+            pool.push([state]() { work(*state); });
+        }
+
+        work(*state);
+        state->finished.await([&state]() { return state->done.load(std::memory_order_acquire) == state->chunk_count; });
+
+        if (state->error)
+        {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    /**
+     * @brief 自动粒度：每个参与线程大约分到8块，兼顾负载均衡和调度开销
+     */
+    static size_t default_grain(ThreadPool& pool, size_t count)
+    {
+        return std::max<size_t>(1, count / ((pool.thread_count() + 1) * 8));
+    }
+
+private:
+    struct State
+    {
+        size_t chunk_count = 0;
+        void* body = nullptr;                           // 调用线程栈上的任务体，只在领到块后访问
+        void (*invoke)(void*, size_t) = nullptr;
+        alignas(64) std::atomic<size_t> next{0};        // 下一个待领取的块
+        alignas(64) std::atomic<size_t> done{0};        // 已完成（或跳过）的块数
+        std::atomic<bool> failed{false};
+        std::mutex error_mutex;
+        std::exception_ptr error;                       // 第一个异常
+        EventCount finished;
+    };
+
+    static void work(State& state)
+    {
+        size_t completed = 0;
+        for (;;)
+        {
+            const size_t chunk = state.next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= state.chunk_count)
+            {
+                break;
+            }
+
+            if (!state.failed.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    state.invoke(state.body, chunk);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(state.error_mutex);
+                    if (!state.error)
+                    {
+                        state.error = std::current_exception();
+                    }
+                    state.failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            ++completed;
+        }
+
+        if (completed != 0 && state.done.fetch_add(completed, std::memory_order_acq_rel) + completed == state.chunk_count)
+        {
+            state.finished.notify_all();
+        }
+    }
+};
+
+/**
+ * @brief 并行分块循环：body(begin, end)处理[begin, end)
+ * @param pool 线程池，调用线程也参与执行
+ * @param first 起始下标（整数或随机访问迭代器）
+ * @param last 结束下标
+ * @param body 块处理函数
+ * @param grain 每块元素数，0表示自动
+ */
+template <typename Index, typename Body>
+void parallel_for_chunked(ThreadPool& pool, Index first, Index last, Body&& body, size_t grain = 0)
+{
+    if (!(first < last))
+    {
+        return;
+    }
+
+    const size_t count = static_cast<size_t>(last - first);
+    if (grain == 0)
+    {
+        grain = ParallelChunkRunner::default_grain(pool, count);
+    }
+
+    const size_t chunk_count = (count + grain - 1) / grain;
+    auto chunk_body = [&](size_t chunk)
+    {
+        const size_t begin = chunk * grain;
+        const size_t end = std::min(count, begin + grain);
+        body(first + begin, first + end);
+    };
+    ParallelChunkRunner::run(pool, chunk_count, chunk_body);
+}
+
+/**
+ * @brief 并行循环：对[first, last)中每个下标调用body(i)
+ * @param grain 每块元素数，0表示自动；单个元素很轻时应调大以摊薄调度开销
+ */
+template <typename Index, typename Body>
+void parallel_for(ThreadPool& pool, Index first, Index last, Body&& body, size_t grain = 0)
+{
+    parallel_for_chunked(pool, first, last, [&body](Index begin, Index end)
+                         {
+                             for (Index i = begin; i != end; ++i)
+                             {
+                                 body(i);
+                             }
+                         }, grain);
+}
+
+/**
+ * @brief 并行变换：out[i] = op(first[i])
+ * @return 输出区间的末尾
+ */
+template <typename InputIt, typename OutputIt, typename UnaryOp>
+OutputIt parallel_transform(ThreadPool& pool, InputIt first, InputIt last, OutputIt out, UnaryOp op, size_t grain = 0)
+{
+    parallel_for_chunked(pool, first, last, [&](InputIt begin, InputIt end)
+                         {
+                             std::transform(begin, end, out + (begin - first), op);
+                         }, grain);
+    return out + (last - first);
+}
+
+/**
+ * @brief 并行归约：init op x0 op x1 op ... op xn-1
+ *
+ * 每块先在本地归约，最后按块顺序合并，所以op只需满足结合律，不要求交换律，结果与块的执行顺序无关。
+ */
+template <typename RandomIt, typename T, typename BinaryOp = std::plus<>>
+T parallel_reduce(ThreadPool& pool, RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp(), size_t grain = 0)
+{
+    if (!(first < last))
+    {
+        return init;
+    }
+
+    const size_t count = static_cast<size_t>(last - first);
+    if (grain == 0)
+    {
+        grain = ParallelChunkRunner::default_grain(pool, count);
+    }
+
+    const size_t chunk_count = (count + grain - 1) / grain;
+    std::vector<std::optional<T>> partials(chunk_count);
+    auto chunk_body = [&](size_t chunk)
+    {
+        RandomIt it = first + chunk * grain;
+        const RandomIt end = first + std::min(count, (chunk + 1) * grain);
+        T acc = *it;
+        for (++it; it != end; ++it)
+        {
+            acc = op(std::move(acc), *it);
+        }
+        partials[chunk].emplace(std::move(acc));
+    };
+    ParallelChunkRunner::run(pool, chunk_count, chunk_body);
+
+    for (auto& partial : partials)
+    {
+        init = op(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+/**
+ * @brief 并行归并排序（不稳定）
+ *
+ * 先把区间切块并行std::sort，再逐轮两两归并；每对的归并按二分查找切成多段并行执行，
+ * 最后几轮也能用满所有线程。需要一块与输入等长的临时缓冲区，元素类型需可默认构造。
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_sort(ThreadPool& pool, RandomIt first, RandomIt last, Compare comp = Compare(), size_t grain = 0)
+{
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+
+    const size_t count = static_cast<size_t>(last - first);
+    if (grain == 0)
+    {
+        grain = std::max<size_t>(4096, ParallelChunkRunner::default_grain(pool, count));
+    }
+
+    if (count <= grain || pool.thread_count() == 0)
+    {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    // 1. 分块排序
+    std::vector<size_t> bounds;
+    for (size_t offset = 0; offset < count; offset += grain)
+    {
+        bounds.push_back(offset);
+    }
+    bounds.push_back(count);
+
+    parallel_for(pool, size_t(0), bounds.size() - 1, [&](size_t run)
+                 {
+                     std::sort(first + bounds[run], first + bounds[run + 1], comp);
+                 }, 1);
+
+    // 2. 两两归并，数据在原区间和缓冲区之间来回搬
+    struct Piece
+    {
+        size_t a_begin, a_end, b_begin, b_end, out;
+    };
+
+    std::vector<Value> buffer(count);
+    bool in_buffer = false;
+    std::vector<Piece> pieces;
+    while (bounds.size() > 2)
+    {
+        auto source = [&](size_t i) -> Value& { return in_buffer ? buffer[i] : first[i]; };
+
+        pieces.clear();
+        std::vector<size_t> merged_bounds;
+        for (size_t run = 0; run + 1 < bounds.size(); run += 2)
+        {
+            const size_t lo = bounds[run];
+            merged_bounds.push_back(lo);
+            if (run + 2 >= bounds.size())
+            {
+                pieces.push_back(Piece{lo, bounds[run + 1], bounds[run + 1], bounds[run + 1], lo});   // 落单的一段原样搬过去
+                continue;
+            }
+
+            const size_t mid = bounds[run + 1];
+            const size_t hi = bounds[run + 2];
+            const size_t splits = std::max<size_t>(1, (hi - lo) / grain);
+            size_t a_prev = lo;
+            size_t b_prev = mid;
+            for (size_t s = 1; s <= splits; ++s)
+            {
+                size_t a_split = mid;
+                size_t b_split = hi;
+                if (s != splits)
+                {
+                    a_split = lo + (mid - lo) * s / splits;
+                    // 与std::merge的相等元素次序一致：B中严格小于A[a_split]的元素排在切分点之前
+                    size_t low = b_prev;
+                    size_t high = hi;
+                    while (low < high)
+                    {
+                        const size_t probe = low + (high - low) / 2;
+                        if (comp(source(probe), source(a_split)))
+                        {
+                            low = probe + 1;
+                        }
+                        else
+                        {
+                            high = probe;
+                        }
+                    }
+                    b_split = low;
+                }
+
+                pieces.push_back(Piece{a_prev, a_split, b_prev, b_split, a_prev + (b_prev - mid)});
+                a_prev = a_split;
+                b_prev = b_split;
+            }
+        }
+        merged_bounds.push_back(count);
+
+        parallel_for(pool, size_t(0), pieces.size(), [&](size_t index)
+                     {
+                         const Piece& piece = pieces[index];
+                         if (in_buffer)
+                         {
+                             std::merge(std::make_move_iterator(buffer.begin() + piece.a_begin), std::make_move_iterator(buffer.begin() + piece.a_end),
+                                        std::make_move_iterator(buffer.begin() + piece.b_begin), std::make_move_iterator(buffer.begin() + piece.b_end),
+                                        first + piece.out, comp);
+                         }
+                         else
+                         {
+                             std::merge(std::make_move_iterator(first + piece.a_begin), std::make_move_iterator(first + piece.a_end),
+                                        std::make_move_iterator(first + piece.b_begin), std::make_move_iterator(first + piece.b_end),
+                                        buffer.begin() + piece.out, comp);
+                         }
+                     }, 1);
+
+        bounds.swap(merged_bounds);
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer)
+    {
+        parallel_for_chunked(pool, size_t(0), count, [&](size_t begin, size_t end)
+                             {
+                                 std::move(buffer.begin() + begin, buffer.begin() + end, first + begin);
+                             });
+    }
+}
+
+#endif // PARALLEL_ALGORITHMS_HPP
@@ -0,0 +1,325 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "Futex.hpp"
+
+/**
+ * @brief 有界单生产者单消费者环形队列
+ *
+ * 只允许一个线程入队、一个线程出队，两端各自只写自己的下标，非阻塞操作无锁、无等待、无动态分配。
+ * 每一端缓存对端下标，只在缓存值显示队列满/空时才读取对端的原子下标，减少缓存行在两个核之间来回迁移。
+ * 支持批量入队/出队（一次发布多个元素），阻塞等待先自旋再休眠。
+ *
+ * @tparam T 队列元素类型（需支持移动）
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity 队列容量（向上取整为2的幂，最小2）
+     * @param blocking 是否支持休眠等待；为false时入队/出队不做唤醒检查，push/wait_pop只自旋和让出
+     */
+    explicit SpscQueue(size_t capacity = 1024, bool blocking = true) : blocking_(blocking)
+    {
+        capacity_ = 2;
+        while (capacity_ < capacity)
+        {
+            capacity_ <<= 1;
+        }
+        mask_ = capacity_ - 1;
+        slots_.reset(new Slot[capacity_]);
+    }
+
+    /**
+     * @brief 析构函数（销毁队列中剩余元素，调用时不能有其他线程在访问队列）
+     */
+    ~SpscQueue()
+    {
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        for (size_t head = head_.load(std::memory_order_relaxed); head != tail; ++head)
+        {
+            item(head)->~T();
+        }
+    }
+
+    /**
+     * @brief 尝试原地构造入队（仅生产者线程调用）
+     * @param args 元素构造参数
+     * @return 成功返回true，队列满返回false
+     */
+    template <typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == capacity_)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == capacity_)
+            {
+                return false;
+            }
+        }
+
+        new (&slots_[tail & mask_]) T(std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        notify(not_empty_);
+        return true;
+    }
+
+    /**
+     * @brief 尝试非阻塞入队（仅生产者线程调用）
+     * @param value 待入队元素（失败时不会被移走）
+     * @return 成功返回true，队列满返回false
+     */
+    bool try_push(T&& value)
+    {
+        return try_emplace(std::move(value));
+    }
+
+    /**
+     * @brief 尝试非阻塞拷贝入队（仅生产者线程调用）
+     */
+    bool try_push(const T& value)
+    {
+        return try_emplace(value);
+    }
+
+    /**
+     * @brief 移动入队（阻塞直到有空间，仅生产者线程调用）
+     * @param value 待入队元素（右值引用）
+     * @return 成功返回true，队列已关闭返回false
+     */
+    bool push(T&& value)
+    {
+        bool pushed = false;
+        not_full_.await([this, &value, &pushed]
+                        {
+                            pushed = !closed() && try_emplace(std::move(value));
+                            return pushed || closed();
+                        }, std::chrono::nanoseconds::max(), blocking_);
+        return pushed;
+    }
+
+    /**
+     * @brief 拷贝入队（阻塞直到有空间，仅生产者线程调用）
+     */
+    bool push(const T& value)
+    {
+        return push(T(value));
+    }
+
+    /**
+     * @brief 批量入队，一次发布（仅生产者线程调用）
+     * @param first 输入迭代器，元素被移动进队列
+     * @param count 最多入队的元素个数
+     * @return 实际入队的元素个数（队列剩余空间不足时小于count）
+     */
+    template <typename InputIt>
+    size_t try_push_bulk(InputIt first, size_t count)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t free_slots = capacity_ - (tail - cached_head_);
+        if (free_slots < count)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            free_slots = capacity_ - (tail - cached_head_);
+        }
+
+        const size_t n = count < free_slots ? count : free_slots;
+        size_t constructed = 0;
+        try
+        {
+            for (; constructed < n; ++constructed, ++first)
+            {
+                new (&slots_[(tail + constructed) & mask_]) T(std::move(*first));
+            }
+        }
+        catch (...)
+        {
+            // 已构造的元素照常发布
+            publish(tail, constructed);
+            throw;
+        }
+
+        publish(tail, n);
+        return n;
+    }
+
+    /**
+     * @brief 尝试非阻塞出队（仅消费者线程调用）
+     * @return 包含元素的std::optional（队列空时返回std::nullopt）
+     */
+    std::optional<T> try_pop()
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_)
+            {
+                return std::nullopt;
+            }
+        }
+
+        T* value = item(head);
+        std::optional<T> result(std::move(*value));
+        value->~T();
+        head_.store(head + 1, std::memory_order_release);
+        notify(not_full_);
+        return result;
+    }
+
+    /**
+     * @brief 阻塞出队（带超时，仅消费者线程调用）
+     * @param timeout 最大等待时间（默认10秒）
+     * @return 包含元素的std::optional（超时或队列已关闭且为空时返回std::nullopt）
+     */
+    std::optional<T> wait_pop(std::chrono::milliseconds timeout = std::chrono::seconds(10))
+    {
+        std::optional<T> value;
+        not_empty_.await([this, &value]
+                         {
+                             // 先读关闭标志再尝试出队，关闭前入队的元素不会被漏掉
+                             const bool was_closed = closed();
+                             value = try_pop();
+                             return value.has_value() || was_closed;
+                         }, timeout, blocking_);
+        return value;
+    }
+
+    /**
+     * @brief 批量出队，一次归还空间（仅消费者线程调用）
+     * @param out 输出迭代器，元素被移动写入
+     * @param max_count 最多出队的元素个数
+     * @return 实际出队的元素个数
+     */
+    template <typename OutputIt>
+    size_t try_pop_bulk(OutputIt out, size_t max_count)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        size_t available = cached_tail_ - head;
+        if (available < max_count)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            available = cached_tail_ - head;
+        }
+
+        const size_t n = max_count < available ? max_count : available;
+        for (size_t i = 0; i < n; ++i, ++out)
+        {
+            T* value = item(head + i);
+            *out = std::move(*value);
+            value->~T();
+        }
+
+        if (n > 0)
+        {
+            head_.store(head + n, std::memory_order_release);
+            notify(not_full_);
+        }
+        return n;
+    }
+
+    /**
+     * @brief 关闭队列：之后push返回false，wait_pop取完剩余元素后返回std::nullopt，并唤醒所有等待者（任意线程可调用）
+     */
+    void close()
+    {
+        closed_.store(true, std::memory_order_release);
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+    /**
+     * @brief 队列是否已关闭
+     */
+    bool closed() const
+    {
+        return closed_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 检查队列是否为空（并发修改时仅为近似值）
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief 获取队列大小（并发修改时仅为近似值）
+     */
+    size_t size() const
+    {
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    /**
+     * @brief 获取队列容量
+     */
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    // 禁用拷贝和赋值
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    T* item(size_t index)
+    {
+        return std::launder(reinterpret_cast<T*>(&slots_[index & mask_]));
+    }
+
+    void publish(size_t tail, size_t count)
+    {
+        if (count > 0)
+        {
+            tail_.store(tail + count, std::memory_order_release);
+            notify(not_empty_);
+        }
+    }
+
+    void notify(EventCount& event)
+    {
+        if (blocking_)
+        {
+            event.notify_one();
+        }
+    }
+
+    std::unique_ptr<Slot[]> slots_;                                // 环形缓冲区
+    size_t capacity_;                                              // 容量（2的幂）
+    size_t mask_;                                                  // capacity_ - 1
+    bool blocking_;                                                // 是否支持休眠等待
+    std::atomic<bool> closed_{false};                              // 是否已关闭
+
+    // 生产者独占的缓存行
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};          // 下一个写入位置
+    size_t cached_head_ = 0;                                       // 生产者缓存的读取位置
+
+    // 消费者独占的缓存行
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};          // 下一个读取位置
+    size_t cached_tail_ = 0;                                       // 消费者缓存的写入位置
+
+    alignas(kCacheLineSize) EventCount not_empty_;                 // 消费者等待
+    alignas(kCacheLineSize) EventCount not_full_;                  // 生产者等待
+};
+
+#endif // SPSC_QUEUE_HPP
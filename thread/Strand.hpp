@@ -0,0 +1,227 @@
+#ifndef STRAND_HPP
+#define STRAND_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <type_traits>
+#include "Task.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @brief 串行执行器：在共享的 ThreadPool 上按提交顺序、互不并发地执行任务
+ *
+ * 与 ThreadExecutor 的语义相同，但不独占线程：只有队列里有任务时才向线程池提交一个调度任务，
+ * 每次最多连续执行 kBatchSize 个任务后重新排队，避免长队列的 Strand 霸占工作线程。
+ * 相邻两个任务可能在不同的工作线程上执行，但前一个任务的写入对后一个任务可见。
+ *
+ * 线程池必须比 Strand 活得久；析构时等待已提交的任务执行完。
+ */
+class Strand
+{
+public:
+    static constexpr size_t kBatchSize = 64;
+
+    /**
+     * @brief 构造函数
+     * @param pool 执行任务的线程池
+     */
+    explicit Strand(ThreadPool& pool) : pool_(pool) {}
+
+    /**
+     * @brief 析构函数（等待已提交的任务执行完；不能在本 Strand 的任务中析构）
+     */
+    ~Strand()
+    {
+        wait_until_idle();
+    }
+
+    Strand(const Strand&) = delete;
+    Strand& operator=(const Strand&) = delete;
+
+    /**
+     * @brief 提交任务（异步执行）
+     * @param task 待执行的任务
+     * @throw std::runtime_error 线程池已停止时抛出异常
+     */
+    void post(Task task)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!scheduled_)
+        {
+            // 持锁提交调度任务：提交失败时抛出异常，状态和队列都未改变；提交成功后 run() 要等解锁才能取任务
+            pool_.push([this]() { run(); });
+            scheduled_ = true;
+        }
+        tasks_.push(std::move(task)); // 已在排队或正在执行时由当前调度顺带执行
+    }
+
+    /**
+     * @brief 提交任务并等待完成（同步执行）
+     *
+     * 在本 Strand 的任务中调用时直接执行，避免自己等自己。
+     * 调用线程是同一线程池的工作线程时会占住该线程等待，线程池只有一个线程时会死锁。
+     *
+     * @param task 待执行的任务
+     * @throw 任务抛出的异常
+     */
+    void postAndWait(Task task)
+    {
+        if (running_in_this_thread())
+        {
+            task();
+            return;
+        }
+
+        std::promise<void> promise;
+        std::future<void> future = promise.get_future();
+        post([task = std::move(task), promise = std::move(promise)]() mutable
+             {
+                 try
+                 {
+                     task();
+                     promise.set_value();
+                 }
+                 catch (...)
+                 {
+                     promise.set_exception(std::current_exception());
+                 }
+             });
+
+        future.get(); // 阻塞直到任务完成，并传递异常
+    }
+
+    /**
+     * @brief 提交带返回值的任务
+     * @tparam ResultType 任务返回值类型
+     * @param task 待执行的任务
+     * @return 获取任务返回值的 future
+     */
+    template <typename ResultType>
+    std::future<ResultType> postAndWaitWithResult(std::function<ResultType()> task)
+    {
+        std::promise<ResultType> promise;
+        std::future<ResultType> future = promise.get_future();
+        post([task = std::move(task), promise = std::move(promise)]() mutable
+             {
+                 try
+                 {
+                     if constexpr (std::is_void<ResultType>::value)
+                     {
+                         task();
+                         promise.set_value();
+                     }
+                     else
+                     {
+                         promise.set_value(task());
+                     }
+                 }
+                 catch (...)
+                 {
+                     promise.set_exception(std::current_exception());
+                 }
+             });
+
+        return future;
+    }
+
+    /**
+     * @brief 当前线程是否正在执行本 Strand 的任务
+     */
+    bool running_in_this_thread() const
+    {
+        return current_ == this;
+    }
+
+    /**
+     * @brief 等待执行的任务数（不含正在执行的一批）
+     */
+    size_t pending() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tasks_.size();
+    }
+
+    /**
+     * @brief 阻塞直到所有已提交的任务执行完（不能在本 Strand 的任务中调用）
+     */
+    void wait_until_idle()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_cond_.wait(lock, [this] { return !scheduled_; });
+    }
+
+private:
+    /**
+     * @brief 线程池上的调度任务：一次加锁取出一批任务依次执行，队列仍非空时重新排队
+     */
+    void run()
+    {
+        Task batch[kBatchSize];
+        size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            count = std::min(kBatchSize, tasks_.size());
+            for (size_t i = 0; i < count; ++i)
+            {
+                batch[i] = std::move(tasks_.front());
+                tasks_.pop();
+            }
+        }
+
+        const Strand* previous = current_;
+        current_ = this;
+        for (size_t i = 0; i < count; ++i)
+        {
+            execute(batch[i]);
+            batch[i] = nullptr;
+        }
+        current_ = previous;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (tasks_.empty())
+            {
+                // 解锁后析构函数可能立即返回，此后不能再访问成员
+                scheduled_ = false;
+                idle_cond_.notify_all();
+                return;
+            }
+        }
+
+        pool_.push_shared([this]() { run(); }); // 让出工作线程：排到共享队列后面，不抢在本线程本地队列中的任务之前
+    }
+
+    /**
+     * @brief 执行单个任务并捕获异常（异常不能逃出 run()，否则 Strand 不会再被调度）
+     */
+    static void execute(Task& task)
+    {
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            fprintf(stderr, "Strand task failed: %s\n", e.what());
+        }
+        catch (...)
+        {
+            fprintf(stderr, "Strand task failed: unknown exception\n");
+        }
+    }
+
+    ThreadPool& pool_;                      // 执行任务的线程池
+    mutable std::mutex mutex_;              // 保护 tasks_、scheduled_
+    std::condition_variable idle_cond_;     // scheduled_ 变为 false 时通知
+    std::queue<Task> tasks_;                // 等待执行的任务
+    bool scheduled_ = false;                // 是否已在线程池排队或正在执行
+
+    inline static thread_local const Strand* current_ = nullptr;   // 当前线程正在执行的 Strand
+};
+
+#endif // STRAND_HPP
@@ -0,0 +1,184 @@
+#ifndef TASK_HPP
+#define TASK_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 只能移动的无参任务，带内联小缓冲区
+ *
+ * 与std::function<void()>相比：不要求可调用对象可拷贝（可以捕获unique_ptr、std::promise等），
+ * 不超过kInlineSize字节、对齐不超过kInlineAlign且移动不抛异常的可调用对象直接放在对象内部，不分配堆内存；
+ * 更大的可调用对象退化为一次堆分配。整个对象正好一条缓存行（64字节）。
+ */
+class Task
+{
+public:
+    static constexpr size_t kInlineAlign = 16;                      // 内联存储的最大对齐
+    static constexpr size_t kInlineSize = 64 - sizeof(void*);       // 内联存储的字节数
+
+    /**
+     * @brief 可调用对象F能否内联存储
+     */
+    template <typename F>
+    static constexpr bool fits_inline = sizeof(F) <= kInlineSize && alignof(F) <= kInlineAlign && std::is_nothrow_move_constructible<F>::value;
+
+    Task() noexcept = default;
+
+    Task(std::nullptr_t) noexcept {}
+
+    template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, Task>::value && std::is_invocable<std::decay_t<F>&>::value>>
+    Task(F&& f)
+    {
+        using Fn = std::decay_t<F>;
+        if constexpr (fits_inline<Fn>)
+        {
+            new (storage_) Fn(std::forward<F>(f));
+            ops_ = &InlineOps<Fn>::table;
+        }
+        else
+        {
+            new (storage_) Fn*(new Fn(std::forward<F>(f)));
+            ops_ = &HeapOps<Fn>::table;
+        }
+    }
+
+    Task(Task&& other) noexcept : ops_(other.ops_)
+    {
+        if (ops_)
+        {
+            ops_->move(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            if (other.ops_)
+            {
+                other.ops_->move(storage_, other.storage_);
+                ops_ = other.ops_;
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    Task& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        reset();
+    }
+
+    /**
+     * @brief 执行任务，空任务调用是未定义行为
+     */
+    void operator()()
+    {
+        ops_->invoke(storage_);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return ops_ != nullptr;
+    }
+
+    /**
+     * @brief 可调用对象是否内联存储（空任务返回true）
+     */
+    bool is_inline() const noexcept
+    {
+        return ops_ == nullptr || ops_->is_inline;
+    }
+
+    /**
+     * @brief 销毁持有的可调用对象
+     */
+    void reset() noexcept
+    {
+        if (ops_)
+        {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    /**
+     * @brief 按存储方式生成的操作表，每种可调用对象类型一份
+     */
+    struct Ops
+    {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept;      // 移动到dst并销毁src
+        void (*destroy)(void* storage) noexcept;
+        bool is_inline;
+    };
+
+    template <typename Fn>
+    struct InlineOps
+    {
+        static void invoke(void* storage)
+        {
+            (*std::launder(static_cast<Fn*>(storage)))();
+        }
+
+        static void move(void* dst, void* src) noexcept
+        {
+            Fn* source = std::launder(static_cast<Fn*>(src));
+            new (dst) Fn(std::move(*source));
+            source->~Fn();
+        }
+
+        static void destroy(void* storage) noexcept
+        {
+            std::launder(static_cast<Fn*>(storage))->~Fn();
+        }
+
+        static constexpr Ops table{&invoke, &move, &destroy, true};
+    };
+
+    template <typename Fn>
+    struct HeapOps
+    {
+        static Fn*& target(void* storage)
+        {
+            return *std::launder(static_cast<Fn**>(storage));
+        }
+
+        static void invoke(void* storage)
+        {
+            (*target(storage))();
+        }
+
+        static void move(void* dst, void* src) noexcept
+        {
+            new (dst) Fn*(target(src));
+        }
+
+        static void destroy(void* storage) noexcept
+        {
+            delete target(storage);
+        }
+
+        static constexpr Ops table{&invoke, &move, &destroy, false};
+    };
+
+    alignas(kInlineAlign) unsigned char storage_[kInlineSize];   // 内联存储的可调用对象，或指向堆上对象的指针
+    const Ops* ops_ = nullptr;                                    // 为空表示空任务
+};
+
+#endif // TASK_HPP
@@ -0,0 +1,620 @@
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "ThreadPool.hpp"
+
+template <typename T>
+class TaskPromise;
+
+/**
+ * @brief 可挂接后续任务的异步结果（共享语义，可以多次get、挂多个then）
+ *
+ * 与std::future不同，then()不会阻塞任何线程：前驱完成时才把后续任务投递到线程池。
+ * 前驱抛出异常时后续任务不会执行，异常沿链路传递到最终的get()。
+ *
+ * @tparam T 结果类型，可以为void
+ */
+template <typename T>
+class TaskFuture
+{
+public:
+    // void结果内部用std::monostate占位
+    using Stored = std::conditional_t<std::is_void<T>::value, std::monostate, T>;
+
+    TaskFuture() = default;
+
+    /**
+     * @brief 是否关联了共享状态
+     */
+    bool valid() const
+    {
+        return state_ != nullptr;
+    }
+
+    /**
+     * @brief 结果是否已就绪（值或异常）
+     */
+    bool is_ready() const
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->ready;
+    }
+
+    /**
+     * @brief 阻塞等待结果就绪（不要在线程池工作线程里调用，否则会占住工作线程）
+     */
+    void wait() const
+    {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->cond.wait(lock, [this] { return state_->ready; });
+    }
+
+    /**
+     * @brief 阻塞获取结果
+     * @return 结果的拷贝（void时无返回值）
+     * @throw 任务抛出的异常
+     */
+    T get() const
+    {
+        wait();
+        if (state_->error)
+        {
+            std::rethrow_exception(state_->error);
+        }
+
+        if constexpr (!std::is_void<T>::value)
+        {
+            return *state_->value;
+        }
+    }
+
+    /**
+     * @brief 挂接后续任务：本任务成功完成后，把f(结果)投递到线程池执行
+     * @param pool 执行后续任务的线程池（需长于任务链存活）
+     * @param f 后续任务，参数为本任务的结果（void时无参数）
+     * @return 后续任务的结果
+     */
+    template <typename F>
+    auto then(ThreadPool& pool, F&& f) const
+    {
+        using R = typename ResultOf<F>::type;
+
+        TaskPromise<R> promise;
+        TaskFuture<R> result = promise.get_future();
+        ThreadPool* target = &pool;
+        on_complete([promise, target, f = std::forward<F>(f)](const std::shared_ptr<State>& state) mutable
+                    {
+                        if (state->error)
+                        {
+                            promise.set_exception(state->error);
+                            return;
+                        }
+
+                        try
+                        {
+                            target->push([promise, state, f = std::move(f)]() mutable
+                                         {
+                                             promise.run([&]() -> R
+                                                         {
+                                                             if constexpr (std::is_void<T>::value)
+                                                             {
+                                                                 return f();
+                                                             }
+                                                             else
+                                                             {
+                                                                 return f(static_cast<const T&>(*state->value));
+                                                             }
+                                                         });
+                                         });
+                        }
+                        catch (...)
+                        {
+                            // 线程池已停止：异常不能逃出续体（上游已完成，不会再被处理），交给下游结果
+                            promise.set_exception(std::current_exception());
+                        }
+                    });
+        return result;
+    }
+
+private:
+    template <typename U>
+    friend class TaskFuture;
+    template <typename U>
+    friend class TaskPromise;
+    template <typename U>
+    friend TaskFuture<std::conditional_t<std::is_void<U>::value, void, std::vector<U>>> when_all(const std::vector<TaskFuture<U>>& futures);
+    template <typename U>
+    friend TaskFuture<std::conditional_t<std::is_void<U>::value, size_t, std::pair<size_t, U>>> when_any(const std::vector<TaskFuture<U>>& futures);
+
+    template <typename F, bool IsVoid = std::is_void<T>::value>
+    struct ResultOf
+    {
+        using type = std::invoke_result_t<std::decay_t<F>&, const T&>;
+    };
+
+    template <typename F>
+    struct ResultOf<F, true>
+    {
+        using type = std::invoke_result_t<std::decay_t<F>&>;
+    };
+
+    /**
+     * @brief 共享状态
+     */
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable cond;
+        bool ready = false;
+        std::optional<Stored> value;
+        std::exception_ptr error;
+        std::vector<std::function<void(const std::shared_ptr<State>&)>> continuations;  // 就绪时在完成线程上调用
+    };
+
+    explicit TaskFuture(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+    /**
+     * @brief 就绪时在完成线程上调用callback（已就绪则立即调用），callback应当很轻
+     */
+    template <typename Callback>
+    void on_complete(Callback&& callback) const
+    {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            if (!state_->ready)
+            {
+                state_->continuations.emplace_back(std::forward<Callback>(callback));
+                return;
+            }
+        }
+
+        callback(state_);
+    }
+
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * @brief TaskFuture的写入端
+ */
+template <typename T>
+class TaskPromise
+{
+public:
+    using State = typename TaskFuture<T>::State;
+    using Stored = typename TaskFuture<T>::Stored;
+
+    TaskPromise() : state_(std::make_shared<State>()) {}
+
+    TaskFuture<T> get_future() const
+    {
+        return TaskFuture<T>(state_);
+    }
+
+    /**
+     * @brief 设置结果（void时不带参数）
+     */
+    template <typename... Args>
+    void set_value(Args&&... args) const
+    {
+        complete([&](State& state) { state.value.emplace(std::forward<Args>(args)...); });
+    }
+
+    /**
+     * @brief 设置异常
+     */
+    void set_exception(std::exception_ptr error) const
+    {
+        complete([&](State& state) { state.error = error; });
+    }
+
+    /**
+     * @brief 执行callable并用其返回值或异常完成结果
+     */
+    template <typename Callable>
+    void run(Callable&& callable) const
+    {
+        try
+        {
+            if constexpr (std::is_void<T>::value)
+            {
+                callable();
+                set_value();
+            }
+            else
+            {
+                set_value(callable());
+            }
+        }
+        catch (...)
+        {
+            set_exception(std::current_exception());
+        }
+    }
+
+private:
+    template <typename Setter>
+    void complete(Setter&& setter) const
+    {
+        std::vector<std::function<void(const std::shared_ptr<State>&)>> continuations;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            if (state_->ready)
+            {
+                return;     // 只有第一次完成生效
+            }
+
+            setter(*state_);
+            state_->ready = true;
+            continuations.swap(state_->continuations);
+        }
+
+        state_->cond.notify_all();
+        for (auto& continuation : continuations)
+        {
+            continuation(state_);
+        }
+    }
+
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * @brief 把f投递到线程池执行，返回可挂接后续任务的结果
+ */
+template <typename F>
+auto spawn_task(ThreadPool& pool, F&& f)
+{
+    using R = std::invoke_result_t<std::decay_t<F>&>;
+    TaskPromise<R> promise;
+    TaskFuture<R> result = promise.get_future();
+    pool.push([promise, f = std::forward<F>(f)]() mutable { promise.run(f); });
+    return result;
+}
+
+/**
+ * @brief 全部完成后就绪：结果按输入顺序排列；任一输入失败时立即以该异常完成
+ */
+template <typename T>
+TaskFuture<std::conditional_t<std::is_void<T>::value, void, std::vector<T>>> when_all(const std::vector<TaskFuture<T>>& futures)
+{
+    using R = std::conditional_t<std::is_void<T>::value, void, std::vector<T>>;
+
+    struct Join
+    {
+        explicit Join(size_t count) : remaining(count), values(count) {}
+
+        std::atomic<size_t> remaining;
+        std::vector<std::optional<typename TaskFuture<T>::Stored>> values;
+        TaskPromise<R> promise;
+    };
+
+    auto join = std::make_shared<Join>(futures.size());
+    TaskFuture<R> result = join->promise.get_future();
+    if (futures.empty())
+    {
+        if constexpr (std::is_void<T>::value)
+        {
+            join->promise.set_value();
+        }
+        else
+        {
+            join->promise.set_value(R{});
+        }
+        return result;
+    }
+
+    for (size_t i = 0; i < futures.size(); ++i)
+    {
+        futures[i].on_complete([join, i](const auto& state)
+                               {
+                                   if (state->error)
+                                   {
+                                       join->promise.set_exception(state->error);
+                                   }
+                                   else
+                                   {
+                                       join->values[i] = state->value;
+                                   }
+
+                                   if (join->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                                   {
+                                       return;
+                                   }
+
+                                   // 最后一个完成者汇总结果（已有异常时set_value不生效）
+                                   if constexpr (std::is_void<T>::value)
+                                   {
+                                       join->promise.set_value();
+                                   }
+                                   else
+                                   {
+                                       std::vector<T> values;
+                                       values.reserve(join->values.size());
+                                       for (auto& value : join->values)
+                                       {
+                                           if (!value)
+                                           {
+                                               return;
+                                           }
+                                           values.push_back(std::move(*value));
+                                       }
+                                       join->promise.set_value(std::move(values));
+                                   }
+                               });
+    }
+
+    return result;
+}
+
+/**
+ * @brief 任一完成后就绪：结果为最先完成的输入下标（及其值）；最先完成的输入失败时以该异常完成
+ * @throw std::invalid_argument 输入为空
+ */
+template <typename T>
+TaskFuture<std::conditional_t<std::is_void<T>::value, size_t, std::pair<size_t, T>>> when_any(const std::vector<TaskFuture<T>>& futures)
+{
+    using R = std::conditional_t<std::is_void<T>::value, size_t, std::pair<size_t, T>>;
+    if (futures.empty())
+    {
+        throw std::invalid_argument("when_any requires at least one future");
+    }
+
+    TaskPromise<R> promise;
+    TaskFuture<R> result = promise.get_future();
+    for (size_t i = 0; i < futures.size(); ++i)
+    {
+        // TaskPromise只接受第一次完成，后完成的输入自动被忽略
+        futures[i].on_complete([promise, i](const auto& state)
+                               {
+                                   if (state->error)
+                                   {
+                                       promise.set_exception(state->error);
+                                   }
+                                   else if constexpr (std::is_void<T>::value)
+                                   {
+                                       promise.set_value(i);
+                                   }
+                                   else
+                                   {
+                                       promise.set_value(R(i, *state->value));
+                                   }
+                               });
+    }
+
+    return result;
+}
+
+/**
+ * @brief 任务依赖图（DAG）执行器
+ *
+ * 先用add添加节点、precede声明依赖，再run到线程池：每个节点维护未完成前驱计数，
+ * 前驱全部完成时由最后一个前驱所在的工作线程投递该节点，整个过程没有线程阻塞等待。
+ * 任一节点抛出异常后，尚未开始的节点被跳过，run返回的结果以第一个异常完成。
+ * 图在运行期间必须存活且不能修改；运行结束后可以再次run。
+ */
+class TaskGraph
+{
+public:
+    using NodeId = size_t;
+
+    /**
+     * @brief 添加节点
+     * @param work 节点任务
+     * @return 节点标识
+     */
+    NodeId add(std::function<void()> work)
+    {
+        nodes_.push_back(Node{std::move(work), {}, 0});
+        return nodes_.size() - 1;
+    }
+
+    /**
+     * @brief 声明依赖：before完成后才执行after
+     */
+    void precede(NodeId before, NodeId after)
+    {
+        if (before >= nodes_.size() || after >= nodes_.size() || before == after)
+        {
+            throw std::invalid_argument("TaskGraph: invalid edge");
+        }
+
+        nodes_[before].successors.push_back(after);
+        nodes_[after].predecessor_count++;
+    }
+
+    /**
+     * @brief 声明依赖：befores全部完成后才执行after
+     */
+    void succeed(NodeId after, std::initializer_list<NodeId> befores)
+    {
+        for (NodeId before : befores)
+        {
+            precede(before, after);
+        }
+    }
+
+    /**
+     * @brief 节点数量
+     */
+    size_t size() const
+    {
+        return nodes_.size();
+    }
+
+    /**
+     * @brief 在线程池上执行整张图
+     * @param pool 线程池
+     * @return 全部节点完成（或第一个异常）时就绪的结果
+     * @throw std::invalid_argument 图中存在环
+     */
+    TaskFuture<void> run(ThreadPool& pool)
+    {
+        check_acyclic();
+
+        auto run = std::make_shared<Run>(*this, pool);
+        TaskFuture<void> result = run->promise.get_future();
+        if (nodes_.empty())
+        {
+            run->promise.set_value();
+            return result;
+        }
+
+        for (NodeId id = 0; id < nodes_.size(); ++id)
+        {
+            if (nodes_[id].predecessor_count == 0)
+            {
+                schedule(run, id);
+            }
+        }
+        return result;
+    }
+
+private:
+    static constexpr NodeId kNone = static_cast<NodeId>(-1);
+
+    struct Node
+    {
+        std::function<void()> work;
+        std::vector<NodeId> successors;
+        size_t predecessor_count;
+    };
+
+    /**
+     * @brief 一次运行的状态，由所有在途任务共享
+     */
+    struct Run
+    {
+        Run(TaskGraph& graph, ThreadPool& pool)
+            : graph(graph), pool(pool), pending(graph.nodes_.size()), remaining(graph.nodes_.size())
+        {
+            for (size_t i = 0; i < graph.nodes_.size(); ++i)
+            {
+                pending[i].store(graph.nodes_[i].predecessor_count, std::memory_order_relaxed);
+            }
+        }
+
+        TaskGraph& graph;
+        ThreadPool& pool;
+        std::vector<std::atomic<size_t>> pending;   // 各节点未完成的前驱数
+        std::atomic<size_t> remaining;              // 未完成的节点数
+        std::atomic<bool> failed{false};            // 是否已有节点失败
+        std::mutex error_mutex;
+        std::exception_ptr error;                   // 第一个异常
+        TaskPromise<void> promise;
+    };
+
+    static void schedule(const std::shared_ptr<Run>& run, NodeId id)
+    {
+        run->pool.push([run, id]() { execute(run, id); });
+    }
+
+    // 从start开始执行，就绪的后继留一个在当前线程上循环执行（不递归，长链不会耗尽栈）
+    static void execute(const std::shared_ptr<Run>& run, NodeId start)
+    {
+        NodeId next = kNone;
+        for (NodeId id = start; id != kNone; id = next)
+        {
+            const Node& node = run->graph.nodes_[id];
+            if (!run->failed.load(std::memory_order_acquire) && node.work)
+            {
+                try
+                {
+                    node.work();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(run->error_mutex);
+                    if (!run->error)
+                    {
+                        run->error = std::current_exception();
+                    }
+                    run->failed.store(true, std::memory_order_release);
+                }
+            }
+
+            // 依赖计数：最后完成的前驱负责投递后继；多个后继就绪时留一个在当前线程继续执行，减少一次投递
+            next = kNone;
+            for (NodeId successor : node.successors)
+            {
+                if (run->pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    if (next != kNone)
+                    {
+                        schedule(run, next);
+                    }
+                    next = successor;
+                }
+            }
+
+            if (run->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::exception_ptr error;
+                {
+                    std::lock_guard<std::mutex> lock(run->error_mutex);
+                    error = run->error;
+                }
+
+                if (error)
+                {
+                    run->promise.set_exception(error);
+                }
+                else
+                {
+                    run->promise.set_value();
+                }
+            }
+        }
+    }
+
+    // Kahn算法检查是否有环
+    void check_acyclic() const
+    {
+        std::vector<size_t> in_degree(nodes_.size());
+        std::vector<NodeId> ready;
+        for (NodeId id = 0; id < nodes_.size(); ++id)
+        {
+            in_degree[id] = nodes_[id].predecessor_count;
+            if (in_degree[id] == 0)
+            {
+                ready.push_back(id);
+            }
+        }
+
+        size_t visited = 0;
+        while (!ready.empty())
+        {
+            const NodeId id = ready.back();
+            ready.pop_back();
+            ++visited;
+            for (NodeId successor : nodes_[id].successors)
+            {
+                if (--in_degree[successor] == 0)
+                {
+                    ready.push_back(successor);
+                }
+            }
+        }
+
+        if (visited != nodes_.size())
+        {
+            throw std::invalid_argument("TaskGraph contains a cycle");
+        }
+    }
+
+    std::vector<Node> nodes_;   // 节点
+};
+
+#endif // TASK_GRAPH_HPP
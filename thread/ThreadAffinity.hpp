@@ -0,0 +1,283 @@
+#ifndef THREAD_AFFINITY_HPP
+#define THREAD_AFFINITY_HPP
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+/**
+ * @brief 线程CPU亲和性工具
+ *
+ * Linux下基于pthread_setaffinity_np/sched_getaffinity；Windows下用SetThreadAffinityMask（仅前64个CPU）；
+ * 其他平台所有设置操作返回false。
+ */
+class ThreadAffinity
+{
+public:
+    /**
+     * @brief 当前进程允许运行的CPU（受taskset、cgroup cpuset限制），升序
+     */
+    static std::vector<int> allowed_cpus()
+    {
+        std::vector<int> cpus;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            {
+                if (CPU_ISSET(cpu, &set))
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+        if (cpus.empty())
+        {
+            const unsigned count = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned cpu = 0; cpu < count; ++cpu)
+            {
+                cpus.push_back(static_cast<int>(cpu));
+            }
+        }
+        return cpus;
+    }
+
+    /**
+     * @brief 把线程绑定到一组CPU
+     * @param handle 线程句柄（std::thread::native_handle()）
+     * @param cpus CPU编号，为空时不做修改
+     * @return 是否成功
+     */
+    static bool pin_thread(std::thread::native_handle_type handle, const std::vector<int>& cpus)
+    {
+        if (cpus.empty())
+        {
+            return false;
+        }
+
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+        {
+            if (cpu >= 0 && cpu < CPU_SETSIZE)
+            {
+                CPU_SET(cpu, &set);
+            }
+        }
+        return pthread_setaffinity_np(handle, sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+        DWORD_PTR mask = 0;
+        for (int cpu : cpus)
+        {
+            if (cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR) * 8))
+            {
+                mask |= DWORD_PTR(1) << cpu;
+            }
+        }
+        return mask != 0 && SetThreadAffinityMask(static_cast<HANDLE>(handle), mask) != 0;
+#else
+        (void)handle;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 把当前线程绑定到一组CPU
+     */
+    static bool pin_current_thread(const std::vector<int>& cpus)
+    {
+#if defined(__linux__)
+        return pin_thread(pthread_self(), cpus);
+#elif defined(_WIN32)
+        return pin_thread(GetCurrentThread(), cpus);
+#else
+        (void)cpus;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 当前线程正在运行的CPU，无法获取时返回-1
+     */
+    static int current_cpu()
+    {
+#if defined(__linux__)
+        return sched_getcpu();
+#elif defined(_WIN32)
+        return static_cast<int>(GetCurrentProcessorNumber());
+#else
+        return -1;
+#endif
+    }
+};
+
+/**
+ * @brief NUMA拓扑：每个节点包含的CPU
+ *
+ * 从/sys/devices/system/node读取，不依赖libnuma；只保留当前进程允许运行的CPU，没有可用CPU的节点
+ * （只有内存的节点、被cpuset排除的节点）不出现在 nodes 中，所以 nodes 的下标不一定等于节点号。
+ * 对外的节点号一律使用内核节点号（与 getcpu、mbind 一致）。
+ * 非Linux或读取失败时视为只有一个节点0。
+ */
+struct NumaTopology
+{
+    /**
+     * @brief 一个有可用CPU的节点
+     */
+    struct Node
+    {
+        int id = 0;             // 内核节点号
+        std::vector<int> cpus;  // 节点的CPU，升序，不为空
+    };
+
+    std::vector<Node> nodes;    // 按节点号升序
+
+    /**
+     * @brief 探测当前机器的拓扑
+     */
+    static NumaTopology detect()
+    {
+        const std::vector<int> allowed = ThreadAffinity::allowed_cpus();
+        NumaTopology topology;
+
+#if defined(__linux__)
+        std::ifstream online("/sys/devices/system/node/online");
+        std::string online_list;
+        std::getline(online, online_list);
+        for (int node : parse_cpu_list(online_list))
+        {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string list;
+            std::getline(file, list);
+
+            std::vector<int> cpus;
+            for (int cpu : parse_cpu_list(list))
+            {
+                if (std::binary_search(allowed.begin(), allowed.end(), cpu))
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+            if (!cpus.empty())
+            {
+                topology.nodes.push_back(Node{node, std::move(cpus)});
+            }
+        }
+#endif
+
+        if (topology.nodes.empty())
+        {
+            topology.nodes.push_back(Node{0, allowed});
+        }
+        return topology;
+    }
+
+    /**
+     * @brief 解析"0-3,8,10-11"格式的CPU（或节点）列表
+     */
+    static std::vector<int> parse_cpu_list(const std::string& list)
+    {
+        std::vector<int> cpus;
+        std::stringstream stream(list);
+        std::string range;
+        while (std::getline(stream, range, ','))
+        {
+            if (range.empty())
+            {
+                continue;
+            }
+
+            const size_t dash = range.find('-');
+            try
+            {
+                const int first = std::stoi(range.substr(0, dash));
+                const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu)
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+            catch (...)
+            {
+            }
+        }
+        std::sort(cpus.begin(), cpus.end());
+        return cpus;
+    }
+
+    /**
+     * @brief 节点数
+     */
+    size_t node_count() const
+    {
+        return nodes.size();
+    }
+
+    /**
+     * @brief 按节点顺序排列的全部CPU
+     */
+    std::vector<int> all_cpus() const
+    {
+        std::vector<int> cpus;
+        for (const auto& node : nodes)
+        {
+            cpus.insert(cpus.end(), node.cpus.begin(), node.cpus.end());
+        }
+        return cpus;
+    }
+
+    /**
+     * @brief CPU所在节点的节点号，不存在时返回-1
+     */
+    int node_of_cpu(int cpu) const
+    {
+        const int index = index_of_cpu(cpu);
+        return index < 0 ? -1 : nodes[index].id;
+    }
+
+    /**
+     * @brief 节点号在 nodes 中的下标，节点没有可用CPU时返回-1
+     */
+    int index_of_node(int id) const
+    {
+        for (size_t index = 0; index < nodes.size(); ++index)
+        {
+            if (nodes[index].id == id)
+            {
+                return static_cast<int>(index);
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief CPU所在节点在 nodes 中的下标，不存在时返回-1
+     */
+    int index_of_cpu(int cpu) const
+    {
+        for (size_t index = 0; index < nodes.size(); ++index)
+        {
+            if (std::binary_search(nodes[index].cpus.begin(), nodes[index].cpus.end(), cpu))
+            {
+                return static_cast<int>(index);
+            }
+        }
+        return -1;
+    }
+};
+
+#endif // THREAD_AFFINITY_HPP
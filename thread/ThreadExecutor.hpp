@@ -10,6 +10,10 @@
 #include <atomic>
 #include <future>
 #include <memory>
+#include <vector>
+#include "SpscQueue.hpp"
+#include "ThreadAffinity.hpp"
+#include "Coroutine.hpp"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -17,6 +21,15 @@
 #include <pthread.h>
 #endif
 
+/**
+ * @brief 任务执行器的投递模式
+ */
+enum class ThreadExecutorMode
+{
+    MultiProducer,  ///< 任意线程都可以投递，加锁队列
+    SingleProducer  ///< 调用方保证只有一个线程投递（不包括执行器线程自身），使用无锁SPSC环形队列，队列满时投递阻塞；不支持协程的 schedule()、post_awaitable()
+};
+
 /**
  * @brief 线程任务执行器（单线程任务队列）
  */
@@ -28,8 +41,17 @@ public:
     /**
      * @brief 构造函数（可选线程名称）
      * @param name 线程名称（用于调试，Windows/Linux不同实现）
+     * @param mode 投递模式
+     * @param queue_capacity SingleProducer模式下的队列容量
      */
-    explicit ThreadExecutor(const std::string& name = "") : name_(name), running_(false) {}
+    explicit ThreadExecutor(const std::string& name = "", ThreadExecutorMode mode = ThreadExecutorMode::MultiProducer, size_t queue_capacity = 1024)
+        : name_(name), running_(false)
+    {
+        if (mode == ThreadExecutorMode::SingleProducer)
+        {
+            spsc_tasks_ = std::make_unique<SpscQueue<Task>>(queue_capacity);
+        }
+    }
 
     /**
      * @brief 析构函数（自动停止并等待线程退出）
@@ -52,7 +74,34 @@ public:
         {
             thread_ = std::thread(&ThreadExecutor::run, this); // 启动工作线程
             set_thread_name(name_); // 设置线程名称（跨平台）
+            if (!cpus_.empty())
+            {
+                ThreadAffinity::pin_thread(thread_.native_handle(), cpus_); // 应用start前设置的亲和性
+            }
+        }
+    }
+
+    /**
+     * @brief 把执行线程绑定到指定CPU（可在start前后调用）
+     * @param cpu CPU编号
+     * @return 线程已启动时返回是否绑定成功；未启动时记录下来，start时生效并返回true
+     */
+    bool set_affinity(int cpu)
+    {
+        return set_affinity(std::vector<int>{cpu});
+    }
+
+    /**
+     * @brief 把执行线程绑定到一组CPU（例如一个NUMA节点的全部CPU）
+     */
+    bool set_affinity(const std::vector<int>& cpus)
+    {
+        cpus_ = cpus;
+        if (thread_.joinable())
+        {
+            return ThreadAffinity::pin_thread(thread_.native_handle(), cpus_);
         }
+        return true;
     }
 
     /**
@@ -62,6 +111,15 @@ public:
     {
         if (running_.exchange(false))
         {
+            if (spsc_tasks_)
+            {
+                spsc_tasks_->close(); // 关闭队列并唤醒工作线程
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_); // 避免通知落在工作线程检查条件与进入等待之间
+            }
             cond_.notify_one(); // 唤醒等待的线程
         }
     }
@@ -78,12 +136,7 @@ public:
             throw std::runtime_error("ThreadExecutor not started");
         }
 
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            tasks_.push(std::move(task)); // 移动任务到队列
-        }
-
-        cond_.notify_one(); // 通知工作线程有新任务
+        enqueue(std::move(task));
     }
 
     /**
@@ -102,25 +155,20 @@ public:
         auto promise_ptr = std::make_shared<std::promise<void>>();
         std::future<void> future = promise_ptr->get_future();
 
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
+        // 使用可拷贝的lambda包装器
+        enqueue([task = std::move(task), promise_ptr]() mutable
+                {
+                    try
+                    {
+                        task(); // 执行原始任务
+                        promise_ptr->set_value(); // 通知等待完成
+                    }
+                    catch (...)
+                    {
+                        promise_ptr->set_exception(std::current_exception()); // 传递异常
+                    }
+                });
 
-            // 使用可拷贝的lambda包装器
-            tasks_.push([task = std::move(task), promise_ptr]() mutable
-                        {
-                            try
-                            {
-                                task(); // 执行原始任务
-                                promise_ptr->set_value(); // 通知等待完成
-                            }
-                            catch (...)
-                            {
-                                promise_ptr->set_exception(std::current_exception()); // 传递异常
-                            }
-                        });
-        }
-
-        cond_.notify_one(); // 通知工作线程
         future.wait(); // 阻塞当前线程直到任务完成
     }
 
@@ -142,32 +190,154 @@ public:
         auto promise_ptr = std::make_shared<std::promise<ResultType>>();
         std::future<ResultType> future = promise_ptr->get_future();
 
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            tasks_.push([task = std::move(task), promise_ptr]() mutable
-                        {
-                            try
-                            {
-                                ResultType result = task(); // 执行原始任务
-                                promise_ptr->set_value(result); // 设置结果
-                            }
-                            catch (...)
-                            {
-                                promise_ptr->set_exception(std::current_exception()); // 传递异常
-                            }
-                        });
-        }
-
-        cond_.notify_one(); // 通知工作线程
+        enqueue([task = std::move(task), promise_ptr]() mutable
+                {
+                    try
+                    {
+                        ResultType result = task(); // 执行原始任务
+                        promise_ptr->set_value(result); // 设置结果
+                    }
+                    catch (...)
+                    {
+                        promise_ptr->set_exception(std::current_exception()); // 传递异常
+                    }
+                });
+
         return future;
     }
 
+#if THREAD_HAS_COROUTINES
+    /**
+     * @brief 协程中 co_await executor.schedule() 后切换到执行器线程上继续执行
+     *
+     * 协程在哪个线程上恢复就从哪个线程投递，可能同时来自多个线程，所以只支持 MultiProducer 模式。
+     *
+     * @throw std::logic_error SingleProducer模式
+     * @throw std::runtime_error co_await 时线程未启动
+     */
+    auto schedule()
+    {
+        require_multi_producer();
+        return ScheduleAwaiter([this](Task task) { post(std::move(task)); });
+    }
+
+    /**
+     * @brief 协程中 co_await executor.post_awaitable(f) 在执行器线程上执行 f 并得到返回值，等待期间不阻塞调用线程
+     *
+     * f 执行完后协程在执行器线程上恢复；f 抛出的异常在 co_await 处重新抛出。
+     * 与 schedule() 一样只支持 MultiProducer 模式。
+     *
+     * @param f 无参可调用对象
+     * @throw std::logic_error SingleProducer模式
+     * @throw std::runtime_error co_await 时线程未启动
+     */
+    template <typename F>
+    auto post_awaitable(F&& f)
+    {
+        require_multi_producer();
+        return CallAwaiter([this](Task task) { post(std::move(task)); }, std::decay_t<F>(std::forward<F>(f)));
+    }
+#endif
+
 private:
+#if THREAD_HAS_COROUTINES
+    /**
+     * @brief 协程等待体从任意线程投递，不能使用SPSC队列
+     */
+    void require_multi_producer() const
+    {
+        if (spsc_tasks_)
+        {
+            throw std::logic_error("ThreadExecutor coroutine awaiters require ThreadExecutorMode::MultiProducer");
+        }
+    }
+#endif
+
+    /**
+     * @brief 任务入队并通知工作线程
+     * @throw std::runtime_error SingleProducer模式下队列已关闭时抛出异常
+     */
+    void enqueue(Task task)
+    {
+        if (spsc_tasks_)
+        {
+            if (!spsc_tasks_->push(std::move(task)))
+            {
+                throw std::runtime_error("ThreadExecutor not started");
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push(std::move(task)); // 移动任务到队列
+        }
+
+        cond_.notify_one(); // 通知工作线程有新任务
+    }
+
+    /**
+     * @brief 执行单个任务并捕获异常
+     */
+    static void execute(Task& task)
+    {
+        try
+        {
+            task(); // 执行任务（可能抛出异常）
+        }
+        catch (const std::exception& e)
+        {
+            // 此处可集成日志模块记录异常（示例：输出到控制台）
+            fprintf(stderr, "Task execution failed: %s\n", e.what());
+        }
+    }
+
+    /**
+     * @brief SingleProducer模式的工作线程主函数：批量取任务，队列关闭且取空后退出
+     */
+    void run_single_producer()
+    {
+        constexpr size_t kBatchSize = 32;
+        Task batch[kBatchSize];
+
+        while (true)
+        {
+            size_t count = spsc_tasks_->try_pop_bulk(batch, kBatchSize);
+            if (count == 0)
+            {
+                auto task = spsc_tasks_->wait_pop();
+                if (!task)
+                {
+                    if (spsc_tasks_->closed() && spsc_tasks_->empty())
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                batch[0] = std::move(*task);
+                count = 1;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                execute(batch[i]);
+                batch[i] = nullptr;
+            }
+        }
+    }
+
     /**
      * @brief 工作线程主函数（循环执行任务）
      */
     void run()
     {
+        if (spsc_tasks_)
+        {
+            run_single_producer();
+            return;
+        }
+
         while (running_.load())
         {
             Task task;
@@ -193,15 +363,7 @@ private:
 
             if (task)
             {
-                try
-                {
-                    task(); // 执行任务（可能抛出异常）
-                }
-                catch (const std::exception& e)
-                {
-                    // 此处可集成日志模块记录异常（示例：输出到控制台）
-                    fprintf(stderr, "Task execution failed: %s\n", e.what());
-                }
+                execute(task);
             }
         }
     }
@@ -244,7 +406,9 @@ private:
     std::mutex mutex_;              // 保护任务队列的互斥锁
     std::condition_variable cond_;  // 条件变量（用于任务通知）
     std::queue<Task> tasks_;        // 任务队列
+    std::unique_ptr<SpscQueue<Task>> spsc_tasks_;   // SingleProducer模式的任务队列
     std::atomic<bool> running_;     // 线程运行状态（原子操作）
+    std::vector<int> cpus_;         // 绑定的CPU，为空表示不绑定
 };
 
 #endif // THREAD_EXECUTOR_HPP
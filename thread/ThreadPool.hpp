@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
 #include <thread>
 #include <mutex>
 #include <queue>
@@ -9,7 +10,202 @@
 #include <future>
 #include <memory>
 #include <stdexcept>
-#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <tuple>
+#include "Task.hpp"
+#include "SizeClassAllocator.hpp"
+#include "ThreadAffinity.hpp"
+#include "Coroutine.hpp"
+
+/**
+ * @brief 线程池调度模式
+ */
+enum class ThreadPoolMode
+{
+    SharedQueue,    ///< 所有工作线程共享一个加锁队列
+    WorkStealing    ///< 每个工作线程一个本地双端队列：本地后进先出，空闲时从随机线程队首窃取，外部提交进入注入队列
+};
+
+/**
+ * @brief 工作线程的CPU亲和性（Linux下基于 pthread_setaffinity_np）
+ */
+enum class ThreadPoolAffinity
+{
+    None,       ///< 不绑定，由操作系统调度
+    PinToCore,  ///< 每个工作线程绑定一个CPU，按NUMA节点顺序依次分配，线程多于CPU时循环
+    NumaNode    ///< 工作线程轮流分到各NUMA节点并绑定到该节点的全部CPU；工作窃取模式下先窃取同节点线程的队列
+};
+
+/**
+ * @brief 任务优先级，数值越小越优先
+ */
+enum class TaskPriority
+{
+    Realtime = 0,   ///< 延迟敏感任务（如请求处理），总是最先执行
+    Normal = 1,     ///< 默认优先级
+    Background = 2  ///< 批量后台任务（如压缩、导出）
+};
+
+/**
+ * @brief 单个优先级队列的统计信息
+ */
+struct ThreadPoolPriorityStats
+{
+    size_t depth = 0;           // 当前排队任务数
+    size_t peak_depth = 0;      // 历史最大排队任务数
+    size_t enqueued = 0;        // 累计入队数
+    size_t dequeued = 0;        // 累计出队数
+    size_t aged = 0;            // 因等待超过老化阈值而被提前执行的任务数
+    uint64_t total_wait_us = 0; // 累计排队等待时间（微秒）
+    uint64_t max_wait_us = 0;   // 最长排队等待时间（微秒）
+
+    // 平均排队等待时间（微秒）
+    double AverageWaitMicros() const
+    {
+        return dequeued ? static_cast<double>(total_wait_us) / dequeued : 0.0;
+    }
+};
+
+/**
+ * @brief 弹性线程池配置
+ *
+ * 线程数在[min_threads, max_threads]之间伸缩：有任务排队超过 spawn_wait_threshold 且没有空闲线程时扩容，
+ * 线程空闲超过 idle_timeout 且多于 min_threads 时退出。
+ */
+struct ThreadPoolElasticConfig
+{
+    size_t min_threads = 1;                                         // 常驻线程数
+    size_t max_threads = std::thread::hardware_concurrency();       // 线程数上限
+    std::chrono::milliseconds spawn_wait_threshold{10};             // 扩容阈值：最老任务的排队时间
+    std::chrono::milliseconds idle_timeout{30000};                  // 缩容阈值：线程连续空闲时间
+    ThreadPoolAffinity affinity = ThreadPoolAffinity::None;         // 工作线程的CPU亲和性
+};
+
+/**
+ * @brief 弹性伸缩统计信息
+ */
+struct ThreadPoolElasticStats
+{
+    size_t threads = 0;                 // 当前工作线程数
+    size_t idle_threads = 0;            // 当前空闲的工作线程数
+    size_t peak_threads = 0;            // 历史最大工作线程数
+    size_t spawned = 0;                 // 累计扩容的线程数（不含初始线程）
+    size_t retired = 0;                 // 累计因空闲退出的线程数
+    uint64_t last_spawn_wait_us = 0;    // 最近一次扩容时最老任务已排队的时间（微秒）
+};
+
+/**
+ * @brief 延迟直方图，按2的幂分桶（纳秒）
+ *
+ * buckets[0] 为 0ns，buckets[k] 为 [2^(k-1), 2^k) ns，最后一个桶包含所有更大的值。
+ */
+struct ThreadPoolLatencyHistogram
+{
+    static constexpr size_t kBuckets = 40;
+
+    uint64_t buckets[kBuckets] = {};    // 各桶的样本数
+    uint64_t count = 0;                 // 样本总数
+    uint64_t total_ns = 0;              // 累计时间（纳秒）
+    uint64_t max_ns = 0;                // 最大值（纳秒）
+
+    // 样本所在的桶
+    static size_t BucketOf(uint64_t ns)
+    {
+        size_t bucket = 0;
+        while (ns != 0 && bucket + 1 < kBuckets)
+        {
+            ns >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    // 平均值（微秒）
+    double AverageMicros() const
+    {
+        return count ? static_cast<double>(total_ns) / count / 1000.0 : 0.0;
+    }
+
+    // 分位数（微秒），取所在桶的上界，不超过最大值；p 取值 [0, 1]
+    double PercentileMicros(double p) const
+    {
+        if (count == 0)
+        {
+            return 0.0;
+        }
+
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * count + 0.5));
+        uint64_t seen = 0;
+        for (size_t k = 0; k < kBuckets; ++k)
+        {
+            seen += buckets[k];
+            if (seen >= rank)
+            {
+                const uint64_t upper = k + 1 < kBuckets ? (uint64_t(1) << k) : max_ns;
+                return static_cast<double>(std::min(upper, max_ns)) / 1000.0;
+            }
+        }
+        return static_cast<double>(max_ns) / 1000.0;
+    }
+
+    // 合并另一个直方图
+    void Merge(const ThreadPoolLatencyHistogram& other)
+    {
+        for (size_t k = 0; k < kBuckets; ++k)
+        {
+            buckets[k] += other.buckets[k];
+        }
+        count += other.count;
+        total_ns += other.total_ns;
+        max_ns = std::max(max_ns, other.max_ns);
+    }
+};
+
+/**
+ * @brief 单个工作线程的运行统计
+ */
+struct ThreadPoolWorkerStats
+{
+    size_t id = 0;                          // 工作线程编号（按启动顺序）
+    uint64_t tasks_completed = 0;           // 执行完的任务数
+    uint64_t exceptions = 0;                // 任务抛出、被线程池吞掉的异常数（enqueue 的异常传给 future，不计入）
+    uint64_t busy_us = 0;                   // 执行任务的累计时间（微秒）
+    uint64_t lifetime_us = 0;               // 线程启动至今的时间（微秒）
+    ThreadPoolLatencyHistogram queue_wait;  // 入队到开始执行的延迟
+    ThreadPoolLatencyHistogram run_time;    // 执行时间
+
+    // 忙碌时间占比，其余时间在等任务
+    double Utilization() const
+    {
+        return lifetime_us ? static_cast<double>(busy_us) / lifetime_us : 0.0;
+    }
+};
+
+/**
+ * @brief 线程池运行统计快照
+ *
+ * 合计值包含弹性模式下已退出的线程，workers 只列出当前的工作线程。
+ * 各计数器分别读取，任务仍在执行时彼此之间可能相差几个任务。
+ */
+struct ThreadPoolStats
+{
+    size_t threads = 0;                     // 当前工作线程数
+    size_t pending = 0;                     // 等待执行的任务数
+    uint64_t tasks_completed = 0;           // 执行完的任务数
+    uint64_t exceptions = 0;                // 被吞掉的异常数
+    uint64_t busy_us = 0;                   // 所有线程执行任务的累计时间（微秒）
+    uint64_t lifetime_us = 0;               // 所有线程的累计存活时间（微秒）
+    ThreadPoolLatencyHistogram queue_wait;  // 入队到开始执行的延迟
+    ThreadPoolLatencyHistogram run_time;    // 执行时间
+    std::vector<ThreadPoolWorkerStats> workers; // 当前各工作线程
+
+    // 整个线程池的忙碌时间占比，接近1说明线程池已饱和
+    double Utilization() const
+    {
+        return lifetime_us ? static_cast<double>(busy_us) / lifetime_us : 0.0;
+    }
+};
 
 class ThreadPool
 {
@@ -18,54 +214,44 @@ public:
   * @brief 线程池构造函数
   *
   * @param[in] threads 线程数量，默认使用硬件并发线程数
+  * @param[in] mode 调度模式，默认共享队列
+  * @param[in] affinity 工作线程的CPU亲和性，默认不绑定
   */
-    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency()) : stop(false)
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency(), ThreadPoolMode mode = ThreadPoolMode::SharedQueue,
+                        ThreadPoolAffinity affinity = ThreadPoolAffinity::None)
+        : stop(false), mode(mode), affinity(affinity)
     {
-        if(threads == 0)
-        {
-            threads = 1;
-        }
+        start(threads);
+    }
 
-        for (size_t i = 0; i < threads; ++i)
+    /**
+  * @brief 弹性线程池构造函数（共享队列模式）
+  *
+  * 启动 min_threads 个线程，另起一个监控线程按配置扩容、回收退出的线程。
+  *
+  * @param[in] config 伸缩配置
+  *
+  * @throws std::invalid_argument 当 max_threads 小于 min_threads 时抛出异常
+  */
+    explicit ThreadPool(const ThreadPoolElasticConfig& config)
+        : stop(false), mode(ThreadPoolMode::SharedQueue), affinity(config.affinity), elastic(true), elastic_config(config)
+    {
+        elastic_config.min_threads = std::max<size_t>(1, elastic_config.min_threads);
+        if (elastic_config.max_threads < elastic_config.min_threads)
         {
-            workers.emplace_back([this]
-                                 {
-                                     while (true)
-                                     {
-                                         std::function<void()> task;
-                                         {
-                                             std::unique_lock<std::mutex> lock(this->queue_mutex);
-                                             this->condition.wait(lock, [this]
-                                                                  {
-                                                                      return this->stop || !this->tasks.empty();
-                                                                  });
-
-                                             if (this->stop && this->tasks.empty())
-                                             {
-                                                 return;
-                                             }
-
-                                             task = std::move(this->tasks.front());
-                                             this->tasks.pop();
-                                         }
-                                         try
-                                         {
-                                             task();
-                                         }
-                                         catch (...)
-                                         {
-                                             std::cerr << "Thread Pool: something wrong.";
-                                         }
-                                     }
-                                 });
+            throw std::invalid_argument("ThreadPool: max_threads is less than min_threads");
         }
+
+        start(elastic_config.min_threads);
+        supervisor = std::thread([this]() { supervise(); });
     }
 
     /**
   * @brief 将任务添加到线程池队列中执行
   *
-  * 此函数接收一个可调用对象和其参数，将其包装成 packaged_task 并加入任务队列，
+  * 此函数接收一个可调用对象和其参数，将其与 promise 一起包装成 Task 并加入任务队列，
   * 然后通知工作线程有新任务到来。返回一个 future 对象用于获取任务执行结果。
+  * 工作窃取模式下，从本池工作线程内提交的任务进入该线程的本地队列。
   *
   * @tparam[in] F 可调用对象的类型
   * @tparam[in] Args 可调用对象参数的类型包
@@ -78,52 +264,177 @@ public:
   */
     template<class F, class... Args>
     auto enqueue(F&& f, Args&&... args) -> std::future<decltype(f(args...))>
+    {
+        return enqueue(TaskPriority::Normal, std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    /**
+  * @brief 按指定优先级将任务添加到线程池队列中执行
+  *
+  * 高优先级任务先于低优先级任务执行；低优先级任务排队超过老化阈值后会被提前执行，避免饿死。
+  *
+  * @param[in] priority 任务优先级
+  * @param[in] f 可调用对象
+  * @param[in] args 可调用对象的参数包
+  *
+  * @return 用于获取任务执行结果的 future 对象
+  *
+  * @throws std::runtime_error 当线程池已停止时抛出异常
+  */
+    template<class F, class... Args>
+    auto enqueue(TaskPriority priority, F&& f, Args&&... args) -> std::future<decltype(f(args...))>
     {
         // 获取可调用对象的返回类型
         using return_type = decltype(f(args...));
 
-        // 将可调用对象和参数绑定，创建 packaged_task 对象
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            [func = std::forward<F>(f), args_tuple = std::make_tuple(std::forward<Args>(args)...)]() mutable
-            {
-                return std::apply(func, std::move(args_tuple));
-            });
+        // promise 的共享状态从内存池分配；promise、可调用对象和参数一起移动进 Task 的内联缓冲区，
+        // 常见的小 lambda 提交时不再有堆分配
+        std::promise<return_type> promise(std::allocator_arg, PoolAllocator<return_type>());
+        std::future<return_type> res = promise.get_future();
+        submit(Task([promise = std::move(promise), func = std::forward<F>(f), args_tuple = std::make_tuple(std::forward<Args>(args)...)]() mutable
+                    {
+                        try
+                        {
+                            if constexpr (std::is_void<return_type>::value)
+                            {
+                                std::apply(func, std::move(args_tuple));
+                                promise.set_value();
+                            }
+                            else
+                            {
+                                promise.set_value(std::apply(func, std::move(args_tuple)));
+                            }
+                        }
+                        catch (...)
+                        {
+                            promise.set_exception(std::current_exception());
+                        }
+                    }),
+               priority);
+        return res;
+    }
 
-        std::future<return_type> res = task->get_future();
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            if(stop)
-            {
-                throw std::runtime_error("enqueue on stopped ThreadPool");
-            }
+    /**
+  * @brief 提交无返回值任务
+  *
+  * 可调用对象只需可移动；不超过 Task::kInlineSize 字节的可调用对象提交时不分配堆内存
+  */
+    template<class F>
+    void push(F&& f)
+    {
+        submit(Task(std::forward<F>(f)), TaskPriority::Normal);
+    }
 
-            tasks.emplace([task]() { (*task)(); });
-        }
+    /**
+  * @brief 按指定优先级提交无返回值任务
+  */
+    template<class F>
+    void push(TaskPriority priority, F&& f)
+    {
+        submit(Task(std::forward<F>(f)), priority);
+    }
 
-        condition.notify_one();
-        return res;
+    /**
+  * @brief 提交任务到共享队列末尾，让出当前工作线程
+  *
+  * 工作窃取模式下工作线程用 push 提交的任务进入自己的本地队列，并且是该线程下一个执行的任务（后进先出）；
+  * 需要排到已有任务之后的续体（如 Strand 的下一批任务）用本函数提交，本地队列中的任务会先执行。
+  * 共享队列模式下等同于 push。
+  */
+    template<class F>
+    void push_shared(F&& f)
+    {
+        submit(Task(std::forward<F>(f)), TaskPriority::Normal, false);
+    }
+
+#if THREAD_HAS_COROUTINES
+    /**
+  * @brief 协程中 co_await pool.schedule() 后切换到本线程池的工作线程上继续执行
+  *
+  * @param[in] priority 恢复协程的任务优先级
+  *
+  * @throws std::runtime_error co_await 时线程池已停止
+  */
+    auto schedule(TaskPriority priority = TaskPriority::Normal)
+    {
+        return ScheduleAwaiter([this, priority](auto&& f) { push(priority, std::forward<decltype(f)>(f)); });
     }
 
+    /**
+  * @brief 协程中 co_await pool.post_awaitable(f) 在线程池上执行 f 并得到返回值，等待期间不阻塞任何线程
+  *
+  * f 执行完后协程在执行 f 的工作线程上恢复；f 抛出的异常在 co_await 处重新抛出。
+  *
+  * @param[in] f 无参可调用对象
+  */
     template<class F>
-    void push(F&& f)
+    auto post_awaitable(F&& f)
+    {
+        return CallAwaiter([this](auto&& task) { push(std::forward<decltype(task)>(task)); }, std::decay_t<F>(std::forward<F>(f)));
+    }
+#endif
+
+    /**
+  * @brief 提交任务到指定 NUMA 节点的工作线程组
+  *
+  * 工作窃取模式且按 NumaNode 绑定时，任务轮流放入该节点工作线程的本地队列，优先由同节点线程执行；
+  * 其他情况、以及该节点没有工作线程（只有内存、被cpuset排除或线程数少于节点数）时等同于 push。
+  *
+  * @param[in] node 内核节点号（与 NumaTopology::Node::id、getcpu、mbind 一致）
+  * @param[in] f 可调用对象
+  */
+    template<class F>
+    void push_to_node(int node, F&& f)
     {
+        const int group = node_workers.empty() ? -1 : topology.index_of_node(node);
+        if (group < 0 || static_cast<size_t>(group) >= node_workers.size())
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            if (stop)
-            {
-                throw std::runtime_error("enqueue on stopped ThreadPool");
-            }
+            push(std::forward<F>(f));
+            return;
+        }
 
-            tasks.emplace(std::forward<F>(f));
+        // 与 submit 的本地快速路径一样不取全局锁；停止后仍允许本池工作线程在排空剩余任务时继续提交
+        if(stop.load(std::memory_order_acquire) && current_pool != this)
+        {
+            throw std::runtime_error("enqueue on stopped ThreadPool");
         }
 
-        condition.notify_one();
+        const std::vector<size_t>& workers_of_node = node_workers[group];
+        push_local(workers_of_node[node_cursor.fetch_add(1, std::memory_order_relaxed) % workers_of_node.size()], Task(std::forward<F>(f)));
+    }
+
+    /**
+  * @brief 设置优先级的老化阈值
+  *
+  * 该优先级的队首任务排队超过阈值后，会先于更高优先级的任务执行。Realtime 的阈值不起作用。
+  *
+  * @param[in] priority 任务优先级
+  * @param[in] threshold 老化阈值
+  */
+    void set_aging_threshold(TaskPriority priority, std::chrono::milliseconds threshold)
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        priority_queues[static_cast<size_t>(priority)].aging_threshold = threshold;
+    }
+
+    /**
+  * @brief 获取某个优先级队列的统计信息
+  *
+  * 工作窃取模式下，工作线程提交到本地队列的 Normal 任务不计入统计。
+  */
+    ThreadPoolPriorityStats get_priority_stats(TaskPriority priority)
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        const PriorityQueue& queue = priority_queues[static_cast<size_t>(priority)];
+        ThreadPoolPriorityStats stats = queue.stats;
+        stats.depth = queue.tasks.size();
+        return stats;
     }
 
     /**
   * @brief 线程池析构函数
   *
-  * 负责安全地停止所有工作线程并清理资源
+  * 负责安全地停止所有工作线程并清理资源，已提交的任务会先执行完
   */
     ~ThreadPool()
     {
@@ -133,6 +444,13 @@ public:
         }
 
         condition.notify_all();
+        supervisor_condition.notify_all();
+
+        // 先停监控线程，此后 workers 不再变化
+        if (supervisor.joinable())
+        {
+            supervisor.join();
+        }
 
         for(std::thread &worker : workers)
         {
@@ -146,20 +464,28 @@ public:
     /**
   * @brief 获取待处理任务的数量
   *
-  * 该函数通过加锁访问任务队列，返回当前队列中等待执行的任务数量。
+  * 返回所有优先级、所有队列中的任务总数。
   *
-  * @return size_t 返回任务队列中的任务数量
+  * @return size_t 返回等待执行的任务数量
   */
     size_t pending_tasks()
+    {
+        return pending_count.load();
+    }
+
+    /**
+  * @brief 获取某个优先级等待处理的任务数量
+  */
+    size_t pending_tasks(TaskPriority priority)
     {
         std::unique_lock<std::mutex> lock(queue_mutex);
-        return tasks.size();
+        return priority_queues[static_cast<size_t>(priority)].tasks.size();
     }
 
     /**
   * @brief 阻塞等待所有任务执行完成
   *
-  * 此函数会等待任务队列中的所有任务执行完毕，但不会停止线程池接收新任务。
+  * 此函数会等待任务队列中的所有任务都被工作线程取走，但不会停止线程池接收新任务。
   * 它通过检查任务队列是否为空来确定所有任务是否已完成。
   *
   * @note 此函数不会阻塞其他线程向队列中添加新任务
@@ -167,14 +493,879 @@ public:
     void wait_until_empty()
     {
         std::unique_lock<std::mutex> lock(queue_mutex);
-        condition.wait(lock, [this] { return tasks.empty(); });
+        empty_condition.wait(lock, [this]
+                             {
+                                 return pending_count.load() == 0;
+                             });
+    }
+
+    /**
+  * @brief 获取调度模式
+  */
+    ThreadPoolMode get_mode() const
+    {
+        return mode;
+    }
+
+    /**
+  * @brief 获取CPU亲和性设置
+  */
+    ThreadPoolAffinity get_affinity() const
+    {
+        return affinity;
+    }
+
+    /**
+  * @brief 工作线程分组对应的 NUMA 节点数（未按 NumaNode 分组时为1）
+  */
+    size_t numa_node_count() const
+    {
+        return node_workers.empty() ? 1 : node_workers.size();
+    }
+
+    /**
+  * @brief 有工作线程分组的 NUMA 节点号（未按 NumaNode 分组时为空），可直接传给 push_to_node
+  */
+    std::vector<int> numa_nodes() const
+    {
+        std::vector<int> ids;
+        for (size_t group = 0; group < node_workers.size(); ++group)
+        {
+            ids.push_back(topology.nodes[group].id);
+        }
+        return ids;
+    }
+
+    /**
+  * @brief 获取工作线程数量
+  */
+    size_t thread_count() const
+    {
+        return live_threads.load();
+    }
+
+    /**
+  * @brief 是否为弹性线程池
+  */
+    bool is_elastic() const
+    {
+        return elastic;
+    }
+
+    /**
+  * @brief 获取弹性伸缩统计信息（非弹性线程池只有 threads、idle_threads、peak_threads 有意义）
+  */
+    ThreadPoolElasticStats get_elastic_stats()
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        ThreadPoolElasticStats stats = elastic_stats;
+        stats.threads = live_threads.load();
+        stats.idle_threads = idle_workers.load();
+        return stats;
+    }
+
+    /**
+  * @brief 获取运行统计快照：排队延迟、执行时间、各线程忙碌占比、完成数和被吞掉的异常数
+  *
+  * 工作线程执行每个任务时无锁地记录到自己的计数器，这里只在复制线程列表时短暂持有 queue_mutex。
+  */
+    ThreadPoolStats get_stats()
+    {
+        std::vector<std::shared_ptr<WorkerMetrics>> metrics;
+        ThreadPoolStats stats;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            metrics = worker_metrics;
+            stats.tasks_completed = retired_metrics.tasks_completed;
+            stats.exceptions = retired_metrics.exceptions;
+            stats.busy_us = retired_metrics.busy_us;
+            stats.lifetime_us = retired_metrics.lifetime_us;
+            stats.queue_wait = retired_metrics.queue_wait;
+            stats.run_time = retired_metrics.run_time;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        for (const auto& worker : metrics)
+        {
+            stats.workers.push_back(worker->snapshot(now));
+            const ThreadPoolWorkerStats& last = stats.workers.back();
+            stats.tasks_completed += last.tasks_completed;
+            stats.exceptions += last.exceptions;
+            stats.busy_us += last.busy_us;
+            stats.lifetime_us += last.lifetime_us;
+            stats.queue_wait.Merge(last.queue_wait);
+            stats.run_time.Merge(last.run_time);
+        }
+
+        stats.threads = live_threads.load();
+        stats.pending = pending_count.load();
+        return stats;
     }
 
 private:
-    std::vector<std::thread> workers;           // 工作线程
-    std::queue<std::function<void()>> tasks;    // 任务队列
+    /**
+  * @brief 设置默认老化阈值并启动初始工作线程
+  */
+    void start(size_t threads)
+    {
+        if(threads == 0)
+        {
+            threads = 1;
+        }
 
-    std::mutex queue_mutex;                     // 互斥锁, stop, tasks
-    std::condition_variable condition;          // 条件变量, queue_mutex
-    bool stop;                                  // 线程池是否停止
+        // 默认老化阈值：Normal 排队超过 100ms、Background 超过 500ms 后优先执行
+        priority_queues[static_cast<size_t>(TaskPriority::Normal)].aging_threshold = std::chrono::milliseconds(100);
+        priority_queues[static_cast<size_t>(TaskPriority::Background)].aging_threshold = std::chrono::milliseconds(500);
+
+        if (affinity != ThreadPoolAffinity::None)
+        {
+            topology = NumaTopology::detect();
+            affinity_cpus = topology.all_cpus();
+        }
+
+        if (mode == ThreadPoolMode::WorkStealing)
+        {
+            for (size_t i = 0; i < threads; ++i)
+            {
+                worker_queues.push_back(std::make_unique<WorkerQueue>());
+            }
+
+            // 记录每个工作线程所在节点，窃取时先找同节点的线程
+            if (affinity != ThreadPoolAffinity::None && topology.node_count() > 1)
+            {
+                for (size_t i = 0; i < threads; ++i)
+                {
+                    worker_nodes.push_back(worker_node(i));
+                }
+            }
+
+            if (affinity == ThreadPoolAffinity::NumaNode && topology.node_count() > 1)
+            {
+                node_workers.resize(std::min(threads, topology.node_count()));
+                for (size_t i = 0; i < threads; ++i)
+                {
+                    node_workers[worker_nodes[i]].push_back(i);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < threads; ++i)
+        {
+            spawn_worker(i);
+        }
+    }
+
+    /**
+  * @brief 启动一个工作线程，index 为工作窃取模式下的本地队列序号
+  */
+    void spawn_worker(size_t index)
+    {
+        auto metrics = std::make_shared<WorkerMetrics>();
+        metrics->id = next_worker_id++;
+        metrics->started = std::chrono::steady_clock::now();
+
+        workers.emplace_back([this, index, cpus = worker_cpus(index), metrics = metrics.get()]
+                             {
+                                 ThreadAffinity::pin_current_thread(cpus);
+                                 current_pool = this;
+                                 current_index = index;
+                                 QueuedTask item;
+                                 while (next_task(index, item))
+                                 {
+                                     run_task(item, *metrics);
+                                 }
+                             });
+        metrics->thread_id = workers.back().get_id();
+        worker_metrics.push_back(std::move(metrics));
+
+        const size_t threads = live_threads.fetch_add(1) + 1;
+        if (threads > elastic_stats.peak_threads)
+        {
+            elastic_stats.peak_threads = threads;
+        }
+    }
+
+    /**
+  * @brief 工作线程所在的 NUMA 节点在 topology.nodes 中的下标
+  */
+    size_t worker_node(size_t index) const
+    {
+        if (affinity == ThreadPoolAffinity::NumaNode)
+        {
+            return index % topology.node_count();
+        }
+
+        const int node = topology.index_of_cpu(affinity_cpus[index % affinity_cpus.size()]);
+        return node < 0 ? 0 : static_cast<size_t>(node);
+    }
+
+    /**
+  * @brief 工作线程要绑定的CPU，为空表示不绑定
+  */
+    std::vector<int> worker_cpus(size_t index) const
+    {
+        switch (affinity)
+        {
+        case ThreadPoolAffinity::PinToCore:
+            return {affinity_cpus[index % affinity_cpus.size()]};
+        case ThreadPoolAffinity::NumaNode:
+            return topology.nodes[worker_node(index)].cpus;
+        default:
+            return {};
+        }
+    }
+
+    /**
+  * @brief 弹性模式的监控线程：共享队列非空时按扩容阈值的一半周期检查是否需要扩容，并回收已退出的线程
+  *
+  * 共享队列为空时不轮询，直到有任务入队或有线程退出时被唤醒
+  */
+    void supervise()
+    {
+        const auto interval = std::max<std::chrono::milliseconds>(std::chrono::milliseconds(1), elastic_config.spawn_wait_threshold / 2);
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        while (!stop)
+        {
+            if (shared_count.load() > 0)
+            {
+                supervisor_condition.wait_for(lock, interval);
+            }
+            else
+            {
+                supervisor_condition.wait(lock);
+            }
+
+            if (stop)
+            {
+                break;
+            }
+
+            // 回收已退出的线程，join 放到锁外
+            if (!retired_ids.empty())
+            {
+                std::vector<std::thread> finished;
+                for (auto it = workers.begin(); it != workers.end();)
+                {
+                    if (std::find(retired_ids.begin(), retired_ids.end(), it->get_id()) != retired_ids.end())
+                    {
+                        finished.push_back(std::move(*it));
+                        it = workers.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+                const std::vector<std::thread::id> finished_ids = std::move(retired_ids);
+                retired_ids.clear();
+
+                lock.unlock();
+                for (std::thread& thread : finished)
+                {
+                    thread.join();
+                }
+                lock.lock();
+                retire_metrics_locked(finished_ids);
+                if (stop)
+                {
+                    break;
+                }
+            }
+
+            grow_locked();
+        }
+    }
+
+    /**
+  * @brief 没有空闲线程且最老任务排队超过阈值时扩容一个线程，调用方持有 queue_mutex
+  */
+    void grow_locked()
+    {
+        if (idle_workers.load() > 0 || shared_count.load() == 0 || live_threads.load() >= elastic_config.max_threads)
+        {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        auto oldest = now;
+        for (const PriorityQueue& queue : priority_queues)
+        {
+            if (!queue.tasks.empty() && queue.tasks.front().enqueue_time < oldest)
+            {
+                oldest = queue.tasks.front().enqueue_time;
+            }
+        }
+
+        if (now - oldest < elastic_config.spawn_wait_threshold)
+        {
+            return;
+        }
+
+        elastic_stats.spawned++;
+        elastic_stats.last_spawn_wait_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - oldest).count());
+        spawn_worker(workers.size());
+    }
+
+    /**
+  * @brief 可增长的环形双端队列
+  *
+  * 容量按2的幂翻倍增长且从不收缩，稳定运行后入队出队不再分配内存（std::deque 每跨过一个内存块就要分配/释放一次）。
+  * 出队时把槽位重置为空对象，及时释放任务捕获的资源。
+  */
+    template <typename T>
+    class RingBuffer
+    {
+    public:
+        bool empty() const
+        {
+            return count_ == 0;
+        }
+
+        size_t size() const
+        {
+            return count_;
+        }
+
+        T& front()
+        {
+            return slots_[head_];
+        }
+
+        const T& front() const
+        {
+            return slots_[head_];
+        }
+
+        T& back()
+        {
+            return slots_[(head_ + count_ - 1) & (slots_.size() - 1)];
+        }
+
+        void push_back(T&& value)
+        {
+            if (count_ == slots_.size())
+            {
+                grow();
+            }
+
+            slots_[(head_ + count_) & (slots_.size() - 1)] = std::move(value);
+            ++count_;
+        }
+
+        void pop_front()
+        {
+            slots_[head_] = T();
+            head_ = (head_ + 1) & (slots_.size() - 1);
+            --count_;
+        }
+
+        void pop_back()
+        {
+            back() = T();
+            --count_;
+        }
+
+    private:
+        void grow()
+        {
+            std::vector<T> slots(slots_.empty() ? 64 : slots_.size() * 2);
+            for (size_t i = 0; i < count_; ++i)
+            {
+                slots[i] = std::move(slots_[(head_ + i) & (slots_.size() - 1)]);
+            }
+            slots_.swap(slots);
+            head_ = 0;
+        }
+
+        std::vector<T> slots_;  // 槽位，大小为0或2的幂
+        size_t head_ = 0;       // 队首槽位
+        size_t count_ = 0;      // 元素个数
+    };
+
+    /**
+  * @brief 排队中的任务，记录入队时间用于老化和统计
+  */
+    struct QueuedTask
+    {
+        Task task;
+        std::chrono::steady_clock::time_point enqueue_time;
+    };
+
+    /**
+  * @brief 工作窃取模式下每个工作线程的本地队列
+  *
+  * 所属线程从队尾压入、弹出（后进先出，缓存局部性好），其他线程从队首窃取（先进先出，优先偷走较早、通常较大的任务）
+  */
+    struct alignas(64) WorkerQueue
+    {
+        std::mutex mutex;
+        RingBuffer<QueuedTask> tasks;
+    };
+
+    /**
+  * @brief 只由一个线程写入的无锁延迟直方图，其他线程可随时读取
+  */
+    struct LatencyRecorder
+    {
+        std::atomic<uint64_t> buckets[ThreadPoolLatencyHistogram::kBuckets] = {};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> total_ns{0};
+        std::atomic<uint64_t> max_ns{0};
+
+        void record(uint64_t ns)
+        {
+            add(buckets[ThreadPoolLatencyHistogram::BucketOf(ns)], 1);
+            add(count, 1);
+            add(total_ns, ns);
+            if (ns > max_ns.load(std::memory_order_relaxed))
+            {
+                max_ns.store(ns, std::memory_order_relaxed);
+            }
+        }
+
+        ThreadPoolLatencyHistogram snapshot() const
+        {
+            ThreadPoolLatencyHistogram histogram;
+            for (size_t k = 0; k < ThreadPoolLatencyHistogram::kBuckets; ++k)
+            {
+                histogram.buckets[k] = buckets[k].load(std::memory_order_relaxed);
+            }
+            histogram.count = count.load(std::memory_order_relaxed);
+            histogram.total_ns = total_ns.load(std::memory_order_relaxed);
+            histogram.max_ns = max_ns.load(std::memory_order_relaxed);
+            return histogram;
+        }
+
+        // 单一写者，不需要原子读改写
+        static void add(std::atomic<uint64_t>& counter, uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+  * @brief 工作线程的运行计数器，只由该线程写入
+  */
+    struct alignas(64) WorkerMetrics
+    {
+        size_t id = 0;                                          // 工作线程编号
+        std::thread::id thread_id;                              // 线程ID，监控线程回收时用, queue_mutex
+        std::chrono::steady_clock::time_point started;          // 启动时间
+        std::atomic<uint64_t> tasks_completed{0};               // 执行完的任务数
+        std::atomic<uint64_t> exceptions{0};                    // 被吞掉的异常数
+        std::atomic<uint64_t> busy_ns{0};                       // 执行任务的累计时间
+        LatencyRecorder queue_wait;                             // 入队到开始执行的延迟
+        LatencyRecorder run_time;                               // 执行时间
+
+        ThreadPoolWorkerStats snapshot(std::chrono::steady_clock::time_point now) const
+        {
+            ThreadPoolWorkerStats stats;
+            stats.id = id;
+            stats.tasks_completed = tasks_completed.load(std::memory_order_relaxed);
+            stats.exceptions = exceptions.load(std::memory_order_relaxed);
+            stats.busy_us = busy_ns.load(std::memory_order_relaxed) / 1000;
+            stats.lifetime_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - started).count());
+            stats.queue_wait = queue_wait.snapshot();
+            stats.run_time = run_time.snapshot();
+            return stats;
+        }
+    };
+
+    static constexpr size_t kPriorityCount = 3;
+
+    /**
+  * @brief 单个优先级的共享队列，受 queue_mutex 保护
+  */
+    struct PriorityQueue
+    {
+        RingBuffer<QueuedTask> tasks;
+        std::chrono::milliseconds aging_threshold{0};  // 0 表示不老化
+        ThreadPoolPriorityStats stats;
+    };
+
+    /**
+  * @brief 提交任务：工作窃取模式下本池工作线程提交的 Normal 任务进入本地队列（allow_local 为 false 时除外），其他任务按优先级进入共享队列
+  */
+    void submit(Task task, TaskPriority priority, bool allow_local = true)
+    {
+        if (allow_local && mode == ThreadPoolMode::WorkStealing && priority == TaskPriority::Normal && current_pool == this)
+        {
+            push_local(current_index, std::move(task));
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            // 停止后仍允许本池工作线程在排空剩余任务时继续提交
+            if(stop && current_pool != this)
+            {
+                throw std::runtime_error("enqueue on stopped ThreadPool");
+            }
+
+            PriorityQueue& queue = priority_queues[static_cast<size_t>(priority)];
+            queue.tasks.push_back(QueuedTask{std::move(task), std::chrono::steady_clock::now()});
+            queue.stats.enqueued++;
+            if (queue.tasks.size() > queue.stats.peak_depth)
+            {
+                queue.stats.peak_depth = queue.tasks.size();
+            }
+            // 弹性模式下共享队列由空变为非空时唤醒监控线程
+            if (shared_count.fetch_add(1) == 0 && elastic)
+            {
+                supervisor_condition.notify_one();
+            }
+            if (priority == TaskPriority::Realtime)
+            {
+                realtime_count.fetch_add(1);
+            }
+            pending_count.fetch_add(1);
+        }
+
+        condition.notify_one();
+    }
+
+    /**
+  * @brief 任务放入指定工作线程的本地队列（工作窃取模式）
+  */
+    void push_local(size_t index, Task task)
+    {
+        // 先计数再入队，保证被窃取后计数不会先减后加
+        WorkerQueue& local = *worker_queues[index];
+        QueuedTask item{std::move(task), std::chrono::steady_clock::now()};
+        pending_count.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(local.mutex);
+            local.tasks.push_back(std::move(item));
+        }
+        wake_one();
+    }
+
+    /**
+  * @brief 按优先级从共享队列取任务，调用方持有 queue_mutex
+  *
+  * 先检查低优先级队首是否已超过老化阈值，超过则先执行它；否则取最高优先级的队首。
+  *
+  * @param[in] urgent_only 只取 Realtime 任务或已老化的任务
+  */
+    bool pop_shared_locked(QueuedTask& item, bool urgent_only)
+    {
+        if (shared_count.load() == 0)
+        {
+            return false;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        size_t chosen = kPriorityCount;
+        bool aged = false;
+
+        // 从最低优先级往上找已老化的队首
+        for (size_t p = kPriorityCount; p-- > 1;)
+        {
+            const PriorityQueue& queue = priority_queues[p];
+            if (!queue.tasks.empty() && queue.aging_threshold.count() > 0 && now - queue.tasks.front().enqueue_time >= queue.aging_threshold)
+            {
+                chosen = p;
+                break;
+            }
+        }
+
+        // 只有越过了更高优先级的任务才算老化提前
+        for (size_t p = 0; p < chosen && chosen < kPriorityCount; ++p)
+        {
+            if (!priority_queues[p].tasks.empty())
+            {
+                aged = true;
+                break;
+            }
+        }
+
+        if (chosen == kPriorityCount)
+        {
+            const size_t last = urgent_only ? 1 : kPriorityCount;
+            for (size_t p = 0; p < last; ++p)
+            {
+                if (!priority_queues[p].tasks.empty())
+                {
+                    chosen = p;
+                    break;
+                }
+            }
+        }
+
+        if (chosen == kPriorityCount)
+        {
+            return false;
+        }
+
+        PriorityQueue& queue = priority_queues[chosen];
+        const uint64_t wait_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - queue.tasks.front().enqueue_time).count());
+        item = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+
+        queue.stats.dequeued++;
+        queue.stats.total_wait_us += wait_us;
+        if (wait_us > queue.stats.max_wait_us)
+        {
+            queue.stats.max_wait_us = wait_us;
+        }
+        if (aged)
+        {
+            queue.stats.aged++;
+        }
+
+        shared_count.fetch_sub(1);
+        if (chosen == static_cast<size_t>(TaskPriority::Realtime))
+        {
+            realtime_count.fetch_sub(1);
+        }
+        return true;
+    }
+
+    /**
+  * @brief 本地队列有新任务时唤醒一个休眠的工作线程
+  *
+  * 工作线程休眠前先登记idle_workers再检查pending_count，提交方先增加pending_count再检查idle_workers，
+  * 两者至少有一方能看到对方的修改；通知前加锁，保证不会落在工作线程检查谓词与进入等待之间
+  */
+    void wake_one()
+    {
+        if (idle_workers.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            condition.notify_one();
+        }
+    }
+
+    /**
+  * @brief 取下一个任务，线程池停止且没有剩余任务时返回false
+  */
+    bool next_task(size_t index, QueuedTask& item)
+    {
+        if (mode == ThreadPoolMode::SharedQueue)
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            while (!stop && shared_count.load() == 0)
+            {
+                idle_workers.fetch_add(1);
+                bool timed_out = false;
+                if (elastic)
+                {
+                    timed_out = condition.wait_for(lock, elastic_config.idle_timeout) == std::cv_status::timeout;
+                }
+                else
+                {
+                    condition.wait(lock);
+                }
+                idle_workers.fetch_sub(1);
+
+                // 弹性模式：空闲超时且多于常驻线程数时退出，由监控线程 join
+                if (timed_out && !stop && shared_count.load() == 0 && live_threads.load() > elastic_config.min_threads)
+                {
+                    live_threads.fetch_sub(1);
+                    elastic_stats.retired++;
+                    retired_ids.push_back(std::this_thread::get_id());
+                    supervisor_condition.notify_one();
+                    return false;
+                }
+            }
+
+            if (!pop_shared_locked(item, false))
+            {
+                return false;
+            }
+
+            if (pending_count.fetch_sub(1) == 1)
+            {
+                empty_condition.notify_all();
+            }
+            return true;
+        }
+
+        while (true)
+        {
+            // 优先处理共享队列中的实时任务和已老化任务；没有实时任务时每隔若干次才检查一次老化，避免频繁争抢 queue_mutex
+            const bool check_urgent = realtime_count.load() > 0 || (shared_count.load() > 0 && (++urgent_check_tick & 15) == 0);
+            if ((check_urgent && pop_injected(item, true)) || pop_local(index, item) || pop_injected(item, false) || steal(index, item))
+            {
+                if (pending_count.fetch_sub(1) == 1)
+                {
+                    std::lock_guard<std::mutex> lock(queue_mutex);
+                    empty_condition.notify_all();
+                }
+                return true;
+            }
+
+            // 所有队列都为空，休眠等待
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            idle_workers.fetch_add(1);
+            condition.wait(lock, [this]
+                           {
+                               return stop || pending_count.load() > 0;
+                           });
+            idle_workers.fetch_sub(1);
+
+            if (stop && pending_count.load() == 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    bool pop_local(size_t index, QueuedTask& item)
+    {
+        WorkerQueue& local = *worker_queues[index];
+        std::lock_guard<std::mutex> lock(local.mutex);
+        if (local.tasks.empty())
+        {
+            return false;
+        }
+
+        item = std::move(local.tasks.back());
+        local.tasks.pop_back();
+        return true;
+    }
+
+    bool pop_injected(QueuedTask& item, bool urgent_only)
+    {
+        if (shared_count.load() == 0)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        return pop_shared_locked(item, urgent_only);
+    }
+
+    /**
+  * @brief 从随机起点开始依次尝试窃取其他工作线程队首的任务
+  *
+  * 工作线程绑定到多个 NUMA 节点时，先找同节点的线程，再跨节点
+  */
+    bool steal(size_t index, QueuedTask& item)
+    {
+        const size_t count = worker_queues.size();
+        if (count < 2)
+        {
+            return false;
+        }
+
+        // xorshift随机数，避免所有空闲线程同时盯住同一个受害者
+        thread_local uint32_t seed = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        const size_t start = seed % count;
+        const size_t passes = worker_nodes.empty() ? 1 : 2;
+        for (size_t pass = 0; pass < passes; ++pass)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t victim = (start + i) % count;
+                if (victim == index || (passes == 2 && (worker_nodes[victim] == worker_nodes[index]) != (pass == 0)))
+                {
+                    continue;
+                }
+
+                WorkerQueue& queue = *worker_queues[victim];
+                std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+                if (!lock.owns_lock() || queue.tasks.empty())
+                {
+                    continue;
+                }
+
+                item = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+  * @brief 执行任务并记录排队延迟、执行时间；任务析构（释放捕获的资源）也计入执行时间
+  */
+    void run_task(QueuedTask& item, WorkerMetrics& metrics)
+    {
+        const auto started = std::chrono::steady_clock::now();
+        metrics.queue_wait.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(started - item.enqueue_time).count()));
+
+        try
+        {
+            item.task();
+        }
+        catch (...)
+        {
+            LatencyRecorder::add(metrics.exceptions, 1);   // 通过 get_stats() 查看，不在工作线程上输出
+        }
+        item.task = nullptr;
+
+        const uint64_t run_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count());
+        metrics.run_time.record(run_ns);
+        LatencyRecorder::add(metrics.busy_ns, run_ns);
+        LatencyRecorder::add(metrics.tasks_completed, 1);
+    }
+
+    /**
+  * @brief 把已 join 的线程的计数器并入 retired_metrics，调用方持有 queue_mutex
+  */
+    void retire_metrics_locked(const std::vector<std::thread::id>& finished)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        for (auto it = worker_metrics.begin(); it != worker_metrics.end();)
+        {
+            if (std::find(finished.begin(), finished.end(), (*it)->thread_id) == finished.end())
+            {
+                ++it;
+                continue;
+            }
+
+            const ThreadPoolWorkerStats stats = (*it)->snapshot(now);
+            retired_metrics.tasks_completed += stats.tasks_completed;
+            retired_metrics.exceptions += stats.exceptions;
+            retired_metrics.busy_us += stats.busy_us;
+            retired_metrics.lifetime_us += stats.lifetime_us;
+            retired_metrics.queue_wait.Merge(stats.queue_wait);
+            retired_metrics.run_time.Merge(stats.run_time);
+            it = worker_metrics.erase(it);
+        }
+    }
+
+    std::vector<std::thread> workers;           // 工作线程
+    PriorityQueue priority_queues[kPriorityCount];  // 按优先级划分的共享任务队列（工作窃取模式下为注入队列）
+
+    std::mutex queue_mutex;                     // 互斥锁, priority_queues
+    std::condition_variable condition;          // 条件变量, queue_mutex
+    std::condition_variable empty_condition;    // 队列清空通知, queue_mutex
+    std::atomic<bool> stop;                     // 线程池是否停止（持有 queue_mutex 时写入，可以不加锁读取）
+
+    ThreadPoolMode mode;                                    // 调度模式
+    ThreadPoolAffinity affinity;                            // CPU亲和性
+    NumaTopology topology;                                  // NUMA拓扑（不绑定时为空）
+    std::vector<int> affinity_cpus;                         // 可绑定的CPU，按节点顺序
+    std::vector<size_t> worker_nodes;                       // 各工作线程所在节点的 topology.nodes 下标（工作窃取模式且跨多个节点时）
+    std::vector<std::vector<size_t>> node_workers;          // 按 topology.nodes 下标的各节点工作线程（工作窃取模式且按 NumaNode 分组时）
+    std::atomic<size_t> node_cursor{0};                     // push_to_node 轮转游标
+    std::vector<std::unique_ptr<WorkerQueue>> worker_queues; // 各工作线程的本地队列（工作窃取模式）
+    std::atomic<size_t> pending_count{0};                   // 所有队列中等待执行的任务数
+    std::atomic<size_t> idle_workers{0};                    // 休眠中的工作线程数
+    std::atomic<size_t> shared_count{0};                    // 共享队列中的任务数
+    std::atomic<size_t> realtime_count{0};                  // 共享队列中的 Realtime 任务数
+    std::atomic<size_t> live_threads{0};                    // 当前工作线程数
+
+    bool elastic = false;                                   // 是否为弹性线程池
+    ThreadPoolElasticConfig elastic_config;                 // 伸缩配置
+    ThreadPoolElasticStats elastic_stats;                   // 伸缩统计, queue_mutex
+    std::vector<std::thread::id> retired_ids;               // 已退出待 join 的线程, queue_mutex
+    std::condition_variable supervisor_condition;           // 唤醒监控线程, queue_mutex
+    std::thread supervisor;                                 // 弹性模式的监控线程
+
+    std::vector<std::shared_ptr<WorkerMetrics>> worker_metrics; // 当前各工作线程的计数器, queue_mutex
+    ThreadPoolWorkerStats retired_metrics;                  // 已退出线程的计数器合计, queue_mutex
+    size_t next_worker_id = 0;                              // 下一个工作线程编号, queue_mutex
+
+    inline static thread_local ThreadPool* current_pool = nullptr;  // 当前线程所属的线程池
+    inline static thread_local size_t current_index = 0;            // 当前线程在所属线程池中的序号
+    inline static thread_local uint32_t urgent_check_tick = 0;       // 工作窃取模式下检查老化任务的节拍
 };
@@ -1,14 +1,20 @@
 #ifndef THREAD_SAFE_QUEUE_HPP
 #define THREAD_SAFE_QUEUE_HPP
 
-#include <queue>
+#include <algorithm>
+#include <deque>
 #include <mutex>
 #include <condition_variable>
 #include <optional>
 #include <chrono>
+#include <utility>
 
 /**
  * @brief 线程安全队列模板类
+ *
+ * 生产者在not_full_上等待空位，消费者在not_empty_上等待元素，互不误唤醒；
+ * close()后不再接受入队，阻塞中的生产者、消费者全部唤醒，消费者取完剩余元素后返回空。
+ *
  * @tparam T 队列元素类型（需支持拷贝/移动）
  */
 template <typename T>
@@ -24,41 +30,49 @@ public:
     /**
      * @brief 拷贝入队（阻塞直到有空间）
      * @param value 待入队元素
-     * @return 成功返回true，队列满返回false（仅当max_size>0时有效）
+     * @return 成功返回true，队列已关闭返回false
      */
     bool push(const T& value)
     {
         std::unique_lock<std::mutex> lock(mutex_);
-
-        // 容量检查（仅当max_size>0时生效）
-        if (max_size_ > 0)
-        {
-            cond_.wait(lock, [this] { return queue_.size() < max_size_; });
-        }
-
-        queue_.push(value);
-        cond_.notify_one(); // 通知等待的消费者
-        return true;
+        not_full_.wait(lock, [this] { return closed_ || !full(); });
+        return push_locked(lock, value);
     }
 
     /**
      * @brief 移动入队（阻塞直到有空间）
      * @param value 待入队元素（右值引用）
-     * @return 成功返回true，队列满返回false（仅当max_size>0时有效）
+     * @return 成功返回true，队列已关闭返回false（此时value未被移动）
      */
     bool push(T&& value)
     {
         std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return closed_ || !full(); });
+        return push_locked(lock, std::move(value));
+    }
 
-        // 容量检查（仅当max_size>0时生效）
-        if (max_size_ > 0)
-        {
-            cond_.wait(lock, [this] { return queue_.size() < max_size_; });
-        }
+    /**
+     * @brief 尝试入队，队列满时最多等待timeout
+     * @param value 待入队元素
+     * @param timeout 最大等待时间（默认不等待）
+     * @return 成功返回true，超时或队列已关闭返回false
+     */
+    bool try_push(const T& value, std::chrono::milliseconds timeout = std::chrono::milliseconds(0))
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait_for(lock, timeout, [this] { return closed_ || !full(); });
+        return !full() && push_locked(lock, value);
+    }
 
-        queue_.emplace(std::move(value)); // 移动构造避免拷贝
-        cond_.notify_one();
-        return true;
+    /**
+     * @brief 尝试移动入队，队列满时最多等待timeout
+     * @return 成功返回true，超时或队列已关闭返回false（此时value未被移动）
+     */
+    bool try_push(T&& value, std::chrono::milliseconds timeout = std::chrono::milliseconds(0))
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait_for(lock, timeout, [this] { return closed_ || !full(); });
+        return !full() && push_locked(lock, std::move(value));
     }
 
     /**
@@ -73,29 +87,92 @@ public:
             return std::nullopt;
         }
 
-        T value = std::move(queue_.front()); // 移动构造避免拷贝
-        queue_.pop();
-        return value;
+        return pop_locked(lock);
     }
 
     /**
      * @brief 阻塞出队（带超时）
      * @param timeout 最大等待时间（默认10秒）
-     * @return 包含元素的std::optional（超时返回std::nullopt）
+     * @return 包含元素的std::optional（超时或队列已关闭且为空时返回std::nullopt）
      */
     std::optional<T> wait_pop(std::chrono::milliseconds timeout = std::chrono::seconds(10))
     {
         std::unique_lock<std::mutex> lock(mutex_);
 
-        // 等待条件：队列非空 或 超时
-        if (!cond_.wait_for(lock, timeout, [this] { return !queue_.empty(); }))
+        // 等待条件：队列非空 或 已关闭 或 超时
+        if (!not_empty_.wait_for(lock, timeout, [this] { return closed_ || !queue_.empty(); }) || queue_.empty())
         {
-            return std::nullopt; // 超时未获取数据
+            return std::nullopt; // 超时或已关闭且没有剩余数据
         }
 
-        T value = std::move(queue_.front());
-        queue_.pop();
-        return value;
+        return pop_locked(lock);
+    }
+
+    /**
+     * @brief 批量出队：一次加锁取出最多max_count个元素，队列空时最多等待timeout
+     * @param out 输出迭代器，元素按入队顺序移动写入
+     * @param max_count 最多取出的元素数
+     * @param timeout 队列空时的最大等待时间（默认不等待）
+     * @return 实际取出的元素数（超时或队列已关闭且为空时为0）
+     */
+    template <typename OutputIt>
+    size_t pop_bulk(OutputIt out, size_t max_count, std::chrono::milliseconds timeout = std::chrono::milliseconds(0))
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait_for(lock, timeout, [this] { return closed_ || !queue_.empty(); });
+
+        const size_t count = std::min(max_count, queue_.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            *out = std::move(queue_.front());
+            ++out;
+            queue_.pop_front();
+        }
+
+        lock.unlock();
+        notify_not_full(count);
+        return count;
+    }
+
+    /**
+     * @brief 一次加锁取走全部元素（与内部容器交换，不逐个移动）
+     * @return 按入队顺序排列的全部元素，队列空时为空
+     */
+    std::deque<T> drain()
+    {
+        std::deque<T> items;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items.swap(queue_);
+        }
+
+        notify_not_full(items.size());
+        return items;
+    }
+
+    /**
+     * @brief 关闭队列：之后的入队失败，唤醒所有等待中的生产者和消费者
+     *
+     * 已入队的元素仍可取出，取完后出队操作立即返回空。重复调用无副作用。
+     */
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+    /**
+     * @brief 队列是否已关闭
+     */
+    bool is_closed() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return closed_;
     }
 
     /**
@@ -119,10 +196,69 @@ public:
     }
 
 private:
-    mutable std::mutex mutex_;          // 互斥锁（mutable允许const成员函数加锁）
-    std::condition_variable cond_;      // 条件变量（用于阻塞等待）
-    std::queue<T> queue_;               // 底层队列
-    size_t max_size_;                   // 最大容量（0表示无界）
+    /**
+     * @brief 队列是否已满（仅当max_size>0时可能为true），调用方持有mutex_
+     */
+    bool full() const
+    {
+        return max_size_ > 0 && queue_.size() >= max_size_;
+    }
+
+    /**
+     * @brief 入队并唤醒一个消费者，调用方持有lock且已确认有空位
+     */
+    template <typename U>
+    bool push_locked(std::unique_lock<std::mutex>& lock, U&& value)
+    {
+        if (closed_)
+        {
+            return false;
+        }
+
+        queue_.emplace_back(std::forward<U>(value)); // 右值时移动构造避免拷贝
+        lock.unlock();
+        not_empty_.notify_one(); // 通知等待的消费者
+        return true;
+    }
+
+    /**
+     * @brief 取出队首并唤醒一个生产者，调用方持有lock且队列非空
+     */
+    T pop_locked(std::unique_lock<std::mutex>& lock)
+    {
+        T value = std::move(queue_.front()); // 移动构造避免拷贝
+        queue_.pop_front();
+        lock.unlock();
+        notify_not_full(1);
+        return value;
+    }
+
+    /**
+     * @brief 取出count个元素后唤醒等待空位的生产者（无界队列的生产者从不等待，不需要通知）
+     */
+    void notify_not_full(size_t count)
+    {
+        if (max_size_ == 0 || count == 0)
+        {
+            return;
+        }
+
+        if (count == 1)
+        {
+            not_full_.notify_one();
+        }
+        else
+        {
+            not_full_.notify_all();
+        }
+    }
+
+    mutable std::mutex mutex_;              // 互斥锁（mutable允许const成员函数加锁）
+    std::condition_variable not_full_;      // 生产者等待空位
+    std::condition_variable not_empty_;     // 消费者等待元素
+    std::deque<T> queue_;                   // 底层队列
+    size_t max_size_;                       // 最大容量（0表示无界）
+    bool closed_ = false;                   // 是否已关闭
 };
 
 #endif // THREAD_SAFE_QUEUE_HPP
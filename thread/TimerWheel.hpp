@@ -0,0 +1,537 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "ThreadExecutor.hpp"
+
+/**
+ * @brief 分层时间轮定时服务（延时任务、周期任务）
+ *
+ * 4层 × 256个槽：第0层每槽1个tick（细粒度），第1层每槽256个tick，第2、3层依次再放大256倍（粗粒度），
+ * 按1ms的tick可覆盖约49天，更远的到期时间被截断到最大范围。
+ * 定时器节点放在数组里、用下标串成双向链表，添加和取消都是O(1)；高层的槽到期时整体下放到低层（级联）。
+ * 定时线程只在最近的非空槽到期或需要级联时醒来，没有定时器时一直休眠。
+ * 回调可以在定时线程上直接执行，也可以投递到指定的ThreadPool或ThreadExecutor。
+ */
+class TimerWheel
+{
+public:
+    using TimerId = uint64_t;       // 定时器句柄（高32位为代数，低32位为节点下标），0表示无效
+    using Callback = std::function<void()>;
+
+    /**
+     * @brief 构造函数（启动定时线程）
+     * @param tick 时间轮精度
+     */
+    explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(1))
+        : tick_(tick.count() > 0 ? tick : std::chrono::milliseconds(1)), start_(std::chrono::steady_clock::now())
+    {
+        for (auto& level : slots_)
+        {
+            for (auto& head : level)
+            {
+                head = kNil;
+            }
+        }
+
+        thread_ = std::thread(&TimerWheel::run, this);
+    }
+
+    /**
+     * @brief 析构函数（停止定时线程，未到期的定时器直接丢弃）
+     */
+    ~TimerWheel()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cond_.notify_one();
+
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+    }
+
+    /**
+     * @brief 延时执行一次，回调在定时线程上执行（应当很短，耗时工作请投递到线程池）
+     * @param delay 延时
+     * @param callback 回调
+     * @return 定时器句柄
+     */
+    TimerId schedule_after(std::chrono::milliseconds delay, Callback callback)
+    {
+        return add_timer(delay, std::chrono::milliseconds(0), std::move(callback), Target{});
+    }
+
+    /**
+     * @brief 延时执行一次，到期时投递到线程池
+     */
+    TimerId schedule_after(std::chrono::milliseconds delay, Callback callback, ThreadPool& pool)
+    {
+        return add_timer(delay, std::chrono::milliseconds(0), std::move(callback), Target{&pool, nullptr});
+    }
+
+    /**
+     * @brief 延时执行一次，到期时投递到任务执行器
+     */
+    TimerId schedule_after(std::chrono::milliseconds delay, Callback callback, ThreadExecutor& executor)
+    {
+        return add_timer(delay, std::chrono::milliseconds(0), std::move(callback), Target{nullptr, &executor});
+    }
+
+    /**
+     * @brief 周期执行，首次在interval之后，回调在定时线程上执行
+     * @param interval 周期（按到期时间累加，不随回调耗时漂移）
+     * @param callback 回调
+     * @return 定时器句柄，调用cancel停止
+     */
+    TimerId schedule_every(std::chrono::milliseconds interval, Callback callback)
+    {
+        return add_timer(interval, interval, std::move(callback), Target{});
+    }
+
+    /**
+     * @brief 周期执行，每次到期时投递到线程池
+     */
+    TimerId schedule_every(std::chrono::milliseconds interval, Callback callback, ThreadPool& pool)
+    {
+        return add_timer(interval, interval, std::move(callback), Target{&pool, nullptr});
+    }
+
+    /**
+     * @brief 周期执行，每次到期时投递到任务执行器
+     */
+    TimerId schedule_every(std::chrono::milliseconds interval, Callback callback, ThreadExecutor& executor)
+    {
+        return add_timer(interval, interval, std::move(callback), Target{nullptr, &executor});
+    }
+
+    /**
+     * @brief 取消定时器（O(1)）
+     *
+     * 定时线程正在执行/投递一批到期回调时会等这一批结束再返回，因此返回后该定时器的回调不会再被执行或投递，
+     * 调用方可以安全地销毁回调引用的对象和目标线程池（在定时线程的回调内部调用时不等待）。
+     *
+     * @param id 定时器句柄
+     * @return 定时器仍在等待并被取消返回true；已触发的一次性定时器、已取消或无效句柄返回false
+     */
+    bool cancel(TimerId id)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const uint32_t index = static_cast<uint32_t>(id);
+        const bool found = index < nodes_.size() && nodes_[index].generation == static_cast<uint32_t>(id >> 32) && nodes_[index].linked;
+        if (found)
+        {
+            unlink(index);
+            release(index);
+        }
+
+        if (dispatching_ && std::this_thread::get_id() != thread_.get_id())
+        {
+            const uint64_t round = dispatch_round_;
+            dispatch_cond_.wait(lock, [this, round] { return !dispatching_ || dispatch_round_ != round; });
+        }
+        return found;
+    }
+
+    /**
+     * @brief 当前等待中的定时器数量
+     */
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return active_count_;
+    }
+
+    /**
+     * @brief 时间轮精度
+     */
+    std::chrono::milliseconds tick() const
+    {
+        return tick_;
+    }
+
+    // 禁用拷贝和赋值
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+private:
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 8;
+    static constexpr uint64_t kSlots = uint64_t(1) << kSlotBits;
+    static constexpr uint64_t kSlotMask = kSlots - 1;
+    static constexpr uint64_t kMaxDelta = (uint64_t(1) << (kSlotBits * kLevels)) - 1;
+
+    /**
+     * @brief 回调投递目标，都为空时在定时线程上执行
+     */
+    struct Target
+    {
+        ThreadPool* pool = nullptr;
+        ThreadExecutor* executor = nullptr;
+    };
+
+    /**
+     * @brief 定时器节点
+     */
+    struct Node
+    {
+        uint32_t prev = kNil;
+        uint32_t next = kNil;
+        uint32_t generation = 1;        // 节点复用时递增，使旧句柄失效
+        uint16_t slot = 0;              // 所在槽（层 * 256 + 槽号）
+        bool linked = false;            // 是否在时间轮中
+        uint64_t expires = 0;           // 到期tick
+        uint64_t interval = 0;          // 周期（tick），0表示一次性
+        Callback callback;
+        Target target;
+    };
+
+    /**
+     * @brief 已到期、等待在锁外执行的回调
+     */
+    struct Fired
+    {
+        Callback callback;
+        Target target;
+    };
+
+    TimerId add_timer(std::chrono::milliseconds delay, std::chrono::milliseconds interval, Callback callback, Target target)
+    {
+        const uint64_t delay_ticks = to_ticks(delay);
+        const uint64_t interval_ticks = interval.count() > 0 ? to_ticks(interval) : 0;
+
+        TimerId id = 0;
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const uint64_t now = now_tick();
+            if (active_count_ == 0 && current_ < now)
+            {
+                // 时间轮为空，直接跳到当前tick，免得定时线程醒来后逐个tick追赶
+                current_ = now;
+            }
+
+            const uint32_t index = acquire();
+            Node& node = nodes_[index];
+            node.expires = now + delay_ticks + 1;    // now_tick向下取整，多加一个tick保证不会提前触发
+            node.interval = interval_ticks;
+            node.callback = std::move(callback);
+            node.target = target;
+            link(index);
+
+            // 比定时线程计划醒来的时间更早到期（或定时线程在无限期休眠）时唤醒它重新计算
+            if (node.expires < wake_tick_)
+            {
+                wake_tick_ = node.expires;
+                wake = true;
+            }
+            id = (static_cast<TimerId>(node.generation) << 32) | index;
+        }
+
+        if (wake)
+        {
+            cond_.notify_one();
+        }
+        return id;
+    }
+
+    // 延时换算成tick（向上取整，至少1个tick）
+    uint64_t to_ticks(std::chrono::milliseconds duration) const
+    {
+        if (duration.count() <= 0)
+        {
+            return 1;
+        }
+        return static_cast<uint64_t>((duration.count() + tick_.count() - 1) / tick_.count());
+    }
+
+    uint64_t now_tick() const
+    {
+        return static_cast<uint64_t>((std::chrono::steady_clock::now() - start_) / tick_);
+    }
+
+    uint32_t acquire()
+    {
+        if (free_head_ != kNil)
+        {
+            const uint32_t index = free_head_;
+            free_head_ = nodes_[index].next;
+            return index;
+        }
+
+        nodes_.emplace_back();
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+    void release(uint32_t index)
+    {
+        Node& node = nodes_[index];
+        node.callback = nullptr;
+        if (++node.generation == 0)
+        {
+            node.generation = 1;    // 保证句柄不为0
+        }
+        node.next = free_head_;
+        free_head_ = index;
+    }
+
+    // 按距离当前tick的远近放入对应层的槽
+    void link(uint32_t index)
+    {
+        Node& node = nodes_[index];
+        uint64_t expires = node.expires;
+        if (expires < current_)
+        {
+            expires = current_;
+        }
+        if (expires - current_ > kMaxDelta)
+        {
+            expires = current_ + kMaxDelta;
+            node.expires = expires;
+        }
+
+        const uint64_t delta = expires - current_;
+        int level = 0;
+        while (level < kLevels - 1 && delta >= (uint64_t(1) << (kSlotBits * (level + 1))))
+        {
+            ++level;
+        }
+        const uint16_t slot = static_cast<uint16_t>(level * kSlots + ((expires >> (kSlotBits * level)) & kSlotMask));
+
+        uint32_t& head = slots_[slot / kSlots][slot % kSlots];
+        node.slot = slot;
+        node.prev = kNil;
+        node.next = head;
+        if (head != kNil)
+        {
+            nodes_[head].prev = index;
+        }
+        head = index;
+        node.linked = true;
+        active_count_++;
+    }
+
+    void unlink(uint32_t index)
+    {
+        Node& node = nodes_[index];
+        if (node.prev != kNil)
+        {
+            nodes_[node.prev].next = node.next;
+        }
+        else
+        {
+            slots_[node.slot / kSlots][node.slot % kSlots] = node.next;
+        }
+        if (node.next != kNil)
+        {
+            nodes_[node.next].prev = node.prev;
+        }
+        node.linked = false;
+        active_count_--;
+    }
+
+    // 把高层槽中的定时器按当前tick重新放入低层，返回槽号（为0表示需要继续级联上一层）
+    uint64_t cascade(int level)
+    {
+        const uint64_t slot = (current_ >> (kSlotBits * level)) & kSlotMask;
+        uint32_t index = slots_[level][slot];
+        slots_[level][slot] = kNil;
+        while (index != kNil)
+        {
+            const uint32_t next = nodes_[index].next;
+            active_count_--;
+            link(index);
+            index = next;
+        }
+        return slot;
+    }
+
+    // 下一个需要处理的tick：第0层最近的非空槽，或高层最近的非空槽开始级联的tick，之前的tick都可以跳过
+    uint64_t next_event_tick() const
+    {
+        uint64_t next = UINT64_MAX;
+        for (int level = 0; level < kLevels; ++level)
+        {
+            const int shift = kSlotBits * level;
+            const uint64_t first = (current_ + (uint64_t(1) << shift) - 1) >> shift;   // 不早于current_的第一个本层槽边界
+            if ((first << shift) >= next)
+            {
+                break;  // 更高层的槽边界不会更早
+            }
+            for (uint64_t k = 0; k < kSlots; ++k)
+            {
+                if (slots_[level][(first + k) & kSlotMask] != kNil)
+                {
+                    next = std::min(next, (first + k) << shift);
+                    break;
+                }
+            }
+        }
+        return next;
+    }
+
+    // 推进到target_tick，收集到期的回调
+    void advance(uint64_t target_tick, std::vector<Fired>& fired)
+    {
+        while (current_ <= target_tick && active_count_ > 0)
+        {
+            // 跳过没有定时器到期、也不需要级联的tick
+            const uint64_t next = next_event_tick();
+            if (next > target_tick)
+            {
+                current_ = target_tick + 1;
+                break;
+            }
+            current_ = next;
+
+            const uint64_t slot = current_ & kSlotMask;
+            if (slot == 0)
+            {
+                for (int level = 1; level < kLevels && cascade(level) == 0; ++level)
+                {
+                }
+            }
+
+            uint32_t index = slots_[0][slot];
+            slots_[0][slot] = kNil;
+            ++current_;
+
+            while (index != kNil)
+            {
+                const uint32_t next = nodes_[index].next;
+                Node& node = nodes_[index];
+                node.linked = false;
+                active_count_--;
+
+                if (node.interval > 0)
+                {
+                    fired.push_back(Fired{node.callback, node.target});
+                    node.expires += node.interval;
+                    if (node.expires <= target_tick)
+                    {
+                        // 定时线程落后时跳过错过的周期，不集中补发
+                        node.expires = target_tick + 1;
+                    }
+                    link(index);
+                }
+                else
+                {
+                    fired.push_back(Fired{std::move(node.callback), node.target});
+                    release(index);
+                }
+                index = next;
+            }
+        }
+
+        // 时间轮为空时直接跟上当前时间
+        if (active_count_ == 0 && current_ <= target_tick)
+        {
+            current_ = target_tick + 1;
+        }
+    }
+
+    static void dispatch(Fired& fired)
+    {
+        try
+        {
+            if (fired.target.pool)
+            {
+                fired.target.pool->push(std::move(fired.callback));
+            }
+            else if (fired.target.executor)
+            {
+                fired.target.executor->post(std::move(fired.callback));
+            }
+            else
+            {
+                fired.callback();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            fprintf(stderr, "Timer callback failed: %s\n", e.what());
+        }
+        catch (...)
+        {
+            fprintf(stderr, "Timer callback failed: unknown exception\n");
+        }
+    }
+
+    /**
+     * @brief 定时线程：休眠到下一个需要处理的tick，时间轮为空时休眠到有新定时器
+     */
+    void run()
+    {
+        std::vector<Fired> fired;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_)
+        {
+            if (active_count_ == 0)
+            {
+                cond_.wait(lock, [this] { return stop_ || active_count_ > 0; });
+                continue;
+            }
+
+            // tick t 从 start_ + t * tick_ 开始，到这个时间点即可处理（add_timer 已经多加了一个tick，不会提前触发）
+            const uint64_t next = next_event_tick();
+            wake_tick_ = next;
+            cond_.wait_until(lock, start_ + tick_ * static_cast<int64_t>(next), [this, next] { return stop_ || wake_tick_ < next; });
+            wake_tick_ = UINT64_MAX;
+            if (stop_)
+            {
+                break;
+            }
+
+            advance(now_tick(), fired);
+            if (fired.empty())
+            {
+                continue;
+            }
+
+            // 在锁外执行/投递回调，回调中可以再添加或取消定时器
+            dispatching_ = true;
+            lock.unlock();
+            for (auto& item : fired)
+            {
+                dispatch(item);
+            }
+            fired.clear();
+            lock.lock();
+            dispatching_ = false;
+            dispatch_round_++;
+            dispatch_cond_.notify_all();
+        }
+    }
+
+    const std::chrono::milliseconds tick_;                  // 时间轮精度
+    const std::chrono::steady_clock::time_point start_;     // tick 0 对应的时间
+    uint64_t current_ = 0;                                  // 下一个要处理的tick
+    uint32_t slots_[kLevels][kSlots];                       // 各层各槽的链表头
+    std::vector<Node> nodes_;                               // 定时器节点
+    uint32_t free_head_ = kNil;                             // 空闲节点链表头
+    size_t active_count_ = 0;                               // 等待中的定时器数量
+    uint64_t wake_tick_ = UINT64_MAX;                       // 定时线程计划醒来的tick，未在定时休眠时为UINT64_MAX
+
+    mutable std::mutex mutex_;                              // 保护以上所有状态
+    std::condition_variable cond_;                          // 唤醒定时线程
+    bool stop_ = false;                                     // 是否停止
+    bool dispatching_ = false;                              // 定时线程是否正在锁外执行/投递回调
+    uint64_t dispatch_round_ = 0;                           // 已完成的回调批次数
+    std::condition_variable dispatch_cond_;                 // 一批回调执行完毕
+    std::thread thread_;                                    // 定时线程
+};
+
+#endif // TIMER_WHEEL_HPP